@@ -0,0 +1,78 @@
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <iostream>
+#include <numeric>
+#include <quile/quile.h>
+
+using namespace quile;
+
+const std::size_t n = 64;
+using G = genotype<g_binary<n>>;
+
+fitness
+one_max(const G& g)
+{
+  return std::accumulate(g.begin(), g.end(), fitness{ 0. });
+}
+
+int
+main()
+{
+  const fitness_db<G> fd{ one_max, constraints_satisfied<G> };
+  const adaptive_mutation<G> m{ { bit_flipping<G>(1. / n),
+                                  random_reset<G>(.5),
+                                  unary_identity<G> } };
+  const adaptive_recombination<G> r{ { one_point_xover<G>,
+                                       uniform_xover<G> } };
+  const variation<G> v{ m, r };
+
+  const ranking_selection<G> rs{ fd, linear_ranking_selection(2.) };
+  const auto p0 = random_population<constraints_satisfied<G>, G>;
+  const auto p1 = stochastic_universal_sampling<G>{ rs };
+  // Offspring is assessed after its evaluation during selection.
+  const auto p2 = adaptive_assessment<G>(
+    adapter<G>(stochastic_universal_sampling<G>{ rs }), fd, m, r);
+  const auto tc = max_iterations_termination<G>(50);
+  evolution<G>(v, p0, p1, p2, tc, 40, 40, 1);
+
+  const auto pm = m.probabilities();
+  const auto pr = r.probabilities();
+  std::cout << "Mutation probabilities:";
+  for (auto p : pm) {
+    std::cout << ' ' << p;
+  }
+  std::cout << "\nRecombination probabilities:";
+  for (auto p : pr) {
+    std::cout << ' ' << p;
+  }
+  std::cout << "\nBest fitness: " << fd(fd.rank_order()[0]) << '\n';
+  assert(std::fabs(std::accumulate(pm.begin(), pm.end(), 0.) - 1.) < 1e-9);
+  assert(std::fabs(std::accumulate(pr.begin(), pr.end(), 0.) - 1.) < 1e-9);
+  // Destructive random reset is never preferred.
+  assert(pm[1] < std::max(pm[0], pm[2]));
+
+  // Parallel variation: records of all threads are merged by assessment,
+  // only the last 100 offspring are assessed.
+  const fitness_db<G> fd4{ one_max, constraints_satisfied<G> };
+  const adaptive_mutation<G> m4{ { bit_flipping<G>(1. / n),
+                                   random_reset<G>(.5),
+                                   unary_identity<G> },
+                                 100 };
+  const variation<G> v4{ m4, r };
+  const ranking_selection<G> rs4{ fd4, linear_ranking_selection(2.) };
+  const auto p24 = adaptive_assessment<G>(
+    adapter<G>(stochastic_universal_sampling<G>{ rs4 }), fd4, m4);
+  evolution<G>(v4,
+               p0,
+               stochastic_universal_sampling<G>{ rs4 },
+               p24,
+               tc,
+               40,
+               40,
+               4);
+  const auto pm4 = m4.probabilities();
+  assert(std::fabs(std::accumulate(pm4.begin(), pm4.end(), 0.) - 1.) < 1e-9);
+  assert(pm4[1] < std::max(pm4[0], pm4[2]));
+}
@@ -0,0 +1,58 @@
+#include <cassert>
+#include <cstddef>
+#include <iostream>
+#include <quile/quile.h>
+
+using namespace quile;
+
+// Eight queens: queen in row i stands in column g.value(i).
+const std::size_t n = 8;
+using G = genotype<g_permutation<int, n, 0>>;
+
+fitness
+attacks(const G& g, const fitness_bound_fn& report)
+{
+  fitness res{ 0 };
+  for (std::size_t i = 1; i < n; ++i) {
+    for (std::size_t j = 0; j < i; ++j) {
+      const auto dc = g.value(i) - g.value(j);
+      res -= static_cast<std::size_t>(dc < 0 ? -dc : dc) == i - j;
+    }
+    // Penalty only grows, so current value is upper bound.
+    if (!report(res)) {
+      break;
+    }
+  }
+  return res;
+}
+
+int
+main()
+{
+  const anytime_evaluator<G> ae{ attacks };
+  const fitness_db<G> fd{ ae, constraints_satisfied<G> };
+
+  const ranking_selection<G> rs{ fd, exponential_ranking_selection };
+  const variation<G> v{ swap_mutation<G>, cut_n_crossfill<G> };
+  const auto p0 = random_population<constraints_satisfied<G>, G>;
+  const auto p1 = stochastic_universal_sampling<G>{ rs };
+  const auto p2 =
+    anytime_cutoff<G>(adapter<G>(stochastic_universal_sampling<G>{ rs }),
+                      fd,
+                      ae);
+  const auto tc = max_iterations_termination<G>(30);
+  evolution<G>(v, p0, p1, p2, tc, 20, 20, 1);
+
+  const G best = fd.rank_order()[0];
+  std::cout << "Best genotype: " << best << " (" << fd(best) << ")\n"
+            << "Completed evaluations: " << ae.completed() << '\n'
+            << "Aborted evaluations: " << ae.aborted() << '\n';
+
+  // Bounds are cached in place of exact values, never below them.
+  for (const auto& [g, f] : fd) {
+    if (const auto b = ae.bound(g)) {
+      assert(f == *b && attacks(g, [](fitness) { return true; }) <= f);
+    }
+  }
+  assert(!ae.bound(best));
+}
@@ -0,0 +1,65 @@
+#include <cassert>
+#include <cstddef>
+#include <iostream>
+#include <quile/quile.h>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+using namespace quile;
+
+const std::size_t n = 12;
+using G = genotype<g_binary<n>>;
+
+// Necklace symmetry: canonical form is the minimal cyclic rotation.
+G
+minimal_rotation(const G& g)
+{
+  G res{ g };
+  for (std::size_t k = 1; k < n; ++k) {
+    typename G::chain_t c{};
+    for (std::size_t i = 0; i < n; ++i) {
+      c[i] = g.value((i + k) % n);
+    }
+    res = std::min(res, G{ c });
+  }
+  return res;
+}
+
+int
+main()
+{
+  // History lines: generation number, genotype and fitness.
+  std::stringstream history{};
+  const G g0 = G::random();
+  const G g1 = G::random();
+  for (std::size_t i = 0; i < 1000; ++i) {
+    const G& g = i % 2 ? g0 : g1;
+    typename G::chain_t c{};
+    for (std::size_t j = 0; j < n; ++j) {
+      c[j] = g.value((i + j) % n);
+    }
+    history << i / 10 << ' ' << G{ c } << ' ' << 0. << '\n';
+  }
+  const std::string text{ history.str() };
+
+  std::istringstream is1{ text };
+  const auto p1 = canonical_history<G>(is1, minimal_rotation, 1, 64);
+  std::istringstream is4{ text };
+  const auto p4 = canonical_history<G>(is4, minimal_rotation, 4, 64);
+  assert(p1 == p4);
+  assert(p1.size() == (minimal_rotation(g0) == minimal_rotation(g1) ? 1 : 2));
+  for (const auto& g : p1) {
+    std::cout << g << '\n';
+  }
+
+  // Malformed line is reported even if chunks are queued behind it.
+  std::istringstream bad{ "0 not-a-genotype 0.\n" + text.substr(0, 400) };
+  bool thrown = false;
+  try {
+    canonical_history<G>(bad, minimal_rotation, 1, 1);
+  } catch (const std::invalid_argument&) {
+    thrown = true;
+  }
+  assert(thrown);
+}
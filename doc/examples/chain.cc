@@ -10,4 +10,6 @@ main()
   const quile::chain<int, 3> c0{ 0, 1, 2 };
   const quile::chain<int, 3> c1{ quile::chain_min(d) };
   assert(c0 == c1);
+  const quile::chain<int, 3> c2{ 5, 6, 7 };
+  assert(c2 == quile::chain_max(d));
 }
@@ -0,0 +1,36 @@
+#include <cassert>
+#include <cstddef>
+#include <future>
+#include <iostream>
+#include <quile/quile.h>
+#include <string>
+#include <vector>
+
+int
+main()
+{
+  using G = quile::genotype<quile::g_binary<16>>;
+  const std::size_t n = 1000;
+  const quile::population<G> p{
+    quile::random_population<quile::constraints_satisfied<G>, G>(n)
+  };
+
+  // Side table filled concurrently, e.g. by fitness function.
+  quile::concurrent_unordered_map<G, std::string> names{};
+  quile::thread_pool tp{ 4 };
+  std::vector<std::future<void>> fs{};
+  for (std::size_t i = 0; i < n; ++i) {
+    fs.push_back(tp.async<void>(std::launch::async, [&, i]() {
+      names.try_emplace(p[i], "genotype_" + std::to_string(i));
+      assert(names.contains(p[i]));
+    }));
+  }
+  for (auto& f : fs) {
+    f.get();
+  }
+
+  std::cout << p[0] << " : " << names.at(p[0]) << '\n';
+  assert(names.size() <= n && names.find(p[n - 1]).has_value());
+  assert(!names.insert_or_assign(p[0], "first") && names.at(p[0]) == "first");
+  assert(names.erase(p[0]) && !names.find(p[0]));
+}
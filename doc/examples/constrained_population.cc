@@ -0,0 +1,57 @@
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <iostream>
+#include <quile/quile.h>
+
+using namespace quile;
+
+const std::size_t n = 100;
+const std::size_t k = 8;
+using G = genotype<g_binary<n>>;
+
+// Exactly k genes are set, random genotype satisfies it with probability
+// about 3e-20.
+bool
+exactly_k(const G& g)
+{
+  return std::ranges::count(g, true) == k;
+}
+
+int
+main()
+{
+  // Constructive sampler sets k distinct random genes.
+  const sampler_fn<G> s = []() {
+    typename G::chain_t c{};
+    for (std::size_t i = 0; i < k;) {
+      if (auto&& x = c[random_U<std::size_t>(0, n - 1)]; !x) {
+        x = true;
+        ++i;
+      }
+    }
+    return G{ c };
+  };
+  const constrained_population<G> cp0{ exactly_k, s };
+  const populate_0_fn<G> p0 = cp0;
+  assert(std::ranges::all_of(p0(10), exactly_k));
+  assert(cp0.candidates() == 10 && cp0.acceptance_rate() == 1.);
+
+  // Repair operator flips random genes until k of them are set.
+  const repair_fn<G> r = [](const G& g) {
+    auto c = g.data();
+    std::size_t m = std::ranges::count(c, true);
+    while (m != k) {
+      if (auto&& x = c[random_U<std::size_t>(0, n - 1)]; x == (m > k)) {
+        x = !x;
+        x ? ++m : --m;
+      }
+    }
+    return G{ c };
+  };
+  const constrained_population<G> cp1{ exactly_k, G::random, r };
+  assert(std::ranges::all_of(cp1(10), exactly_k));
+  assert(cp1.accepted() == 10 && cp1.repaired() <= 10);
+  std::cout << "Repaired: " << cp1.repaired() << ", acceptance rate: "
+            << cp1.acceptance_rate() << '\n';
+}
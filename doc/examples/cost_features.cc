@@ -0,0 +1,63 @@
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <cstddef>
+#include <iostream>
+#include <quile/quile.h>
+#include <thread>
+#include <vector>
+
+using namespace quile;
+
+using G = genotype<g_binary<12>>;
+
+// Numbers of ones in both halves of genotype (e.g. numbers of atoms of two
+// elements).
+std::vector<double>
+ones(const G& g)
+{
+  return { static_cast<double>(std::count(g.begin(), g.begin() + 6, true)),
+           static_cast<double>(std::count(g.begin() + 6, g.end(), true)) };
+}
+
+// Ones in the first half are three times more expensive.
+fitness
+slow_onemax(const G& g)
+{
+  const auto xs = ones(g);
+  std::this_thread::sleep_for(std::chrono::milliseconds(1) *
+                              (3 * xs[0] + xs[1]));
+  return xs[0] + xs[1];
+}
+
+int
+main()
+{
+  const auto p = random_population<constraints_satisfied<G>, G>(24);
+
+  const fitness_db<G> fifo{ slow_onemax, constraints_satisfied<G>, 4 };
+  fifo(p);
+  const auto s0 = fifo.last_schedule();
+  std::cout << "FIFO: " << s0.makespan << " s\n";
+  assert(s0.simulated == s0.fifo);
+
+  const fitness_db<G> lpt{ slow_onemax, constraints_satisfied<G>, 4 };
+  lpt.cost_features(ones);
+  G::chain_t c0{};
+  G::chain_t c1{};
+  std::fill(c0.begin(), c0.begin() + 4, true);
+  std::fill(c1.begin() + 6, c1.end(), true);
+  const G g0{ c0 };
+  const G g1{ c1 };
+  // Before any measurement genotypes are ordered by sum of features.
+  assert(lpt.predicted_cost(g0) < lpt.predicted_cost(g1));
+  lpt(p);
+  const auto s1 = lpt.last_schedule();
+  std::cout << "LPT:  " << s1.makespan << " s (simulated: " << s1.simulated
+            << " s, simulated FIFO: " << s1.fifo << " s)\n";
+
+  // Evaluation times measured for population reverse the order.
+  std::cout << "Predicted costs: " << lpt.predicted_cost(g0) << " s, "
+            << lpt.predicted_cost(g1) << " s\n";
+  assert(lpt.predicted_cost(g0) > lpt.predicted_cost(g1));
+}
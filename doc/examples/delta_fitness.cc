@@ -0,0 +1,122 @@
+#include <atomic>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <iostream>
+#include <quile/quile.h>
+#include <tuple>
+
+using namespace quile;
+using type = double;
+const std::size_t dim = 10;
+static const auto d = uniform_domain<type, dim>(-10., +10.);
+using G = genotype<g_floating_point<type, dim, &d>>;
+
+// Fitness function with incremental evaluation; counts both kinds of calls.
+struct negated_sphere
+{
+  std::atomic<std::size_t>* full;
+  std::atomic<std::size_t>* incremental;
+
+  fitness operator()(const G& g) const
+  {
+    ++*full;
+    fitness res{ 0. };
+    for (auto x : g) {
+      res -= x * x;
+    }
+    return res;
+  }
+
+  fitness delta(const G& parent,
+                fitness parent_fitness,
+                const G& child,
+                const loci& changed) const
+  {
+    ++*incremental;
+    fitness res{ parent_fitness };
+    for (auto i : changed) {
+      res += parent.value(i) * parent.value(i) - child.value(i) * child.value(i);
+    }
+    return res;
+  }
+};
+
+int
+main()
+{
+  std::atomic<std::size_t> full{ 0 };
+  std::atomic<std::size_t> incremental{ 0 };
+  const negated_sphere f{ &full, &incremental };
+  const fitness_db<G> fd{ f, constraints_satisfied<G>, 1 };
+  const auto m = delta_mutation<G>(traced_random_reset<G>(0.2), fd);
+
+  G g = G::random();
+  std::cout << "Initial genotype: " << g << " (" << fd(g) << ")\n";
+  for (int i = 0; i < 100; ++i) {
+    const G c = m(g).at(0);
+    const fitness fc = fd(c);
+    assert(std::fabs(fc - f(c)) < 1e-9);
+    if (fc > fd(g)) {
+      g = c;
+    }
+  }
+  std::cout << "Final genotype: " << g << " (" << fd(g) << ")\n";
+  std::cout << "Full evaluations: " << full << ", incremental evaluations: "
+            << incremental << '\n';
+  assert(incremental > 0);
+
+  // Population evaluation in many threads also uses incremental evaluation.
+  const fitness_db<G> fd2{ f, constraints_satisfied<G>, 4 };
+  const G g0 = G::random();
+  fd2(g0);
+  population<G> p{};
+  for (int i = 0; i < 10; ++i) {
+    const auto [c, changed] = traced_swap_mutation(g0);
+    fd2.descent(g0, c, changed);
+    p.push_back(c);
+  }
+  const std::size_t before = incremental;
+  const fitnesses fs = fd2(p);
+  for (std::size_t i = 0; i < p.size(); ++i) {
+    assert(std::fabs(fs[i] - f(p[i])) < 1e-9);
+  }
+  std::cout << "Incremental evaluations for population: "
+            << incremental - before << '\n';
+
+  // Descent is kept until its child is evaluated, also after evaluation of
+  // another population (e.g. in selection). Child differs from its new parent,
+  // so it is not in the database yet.
+  const G g1 = G::random();
+  fd2(g1);
+  auto [c0, changed0] = traced_swap_mutation(g1);
+  while (c0 == g1) {
+    std::tie(c0, changed0) = traced_swap_mutation(g1);
+  }
+  fd2.descent(g1, c0, changed0);
+  fd2(population<G>{ G::random(), G::random() });
+  const std::size_t after = incremental;
+  fd2(c0);
+  assert(incremental == after + 1);
+
+  // Evolution: mutated children of recombination are evaluated incrementally
+  // with respect to parents of variation.
+  const fitness_db<G> fd3{ f, constraints_satisfied<G>, 1 };
+  const variation<G> v{ delta_mutation<G>(traced_random_reset<G>(0.1), fd3),
+                        single_arithmetic_recombination<G> };
+  const ranking_selection<G> rs{ fd3, linear_ranking_selection(2.) };
+  const auto p0 = random_population<constraints_satisfied<G>, G>;
+  const auto p1 = stochastic_universal_sampling<G>{ rs };
+  const auto p2 = adapter<G>(stochastic_universal_sampling<G>{ rs });
+  const std::size_t full0 = full;
+  const std::size_t incremental0 = incremental;
+  evolution<G>(v, p0, p1, p2, max_iterations_termination<G>(20), 40, 40, 1);
+  std::cout << "Evolution: full evaluations: " << full - full0
+            << ", incremental evaluations: " << incremental - incremental0
+            << '\n';
+  assert(incremental - incremental0 > full - full0);
+
+  // Traced mutation can be used as ordinary mutation as well.
+  const mutation_fn<G> u = untraced<G>(traced_random_reset<G>(0.5));
+  std::cout << "Mutated genotype: " << u(g).at(0) << '\n';
+}
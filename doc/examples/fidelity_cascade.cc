@@ -0,0 +1,68 @@
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <iostream>
+#include <quile/quile.h>
+
+using namespace quile;
+using namespace quile::test_functions;
+
+using type = double;
+const std::size_t dim = 4;
+const test_function<type, dim> fn = Ackley<type, dim>;
+const auto d = fn.function_domain();
+using G = genotype<g_floating_point<type, dim, &d>>;
+
+int
+main()
+{
+  // Cheap, coarse approximation followed by expensive, exact fitness function.
+  const fitness_function<G> coarse = [](const G& g) {
+    chain<type, dim> c{ g.data() };
+    for (auto& x : c) {
+      x = std::round(x);
+    }
+    return -fn(c);
+  };
+  const fitness_function<G> exact = [](const G& g) { return -fn(g.data()); };
+
+  // Only genotypes with coarse value among best quarter of coarse values
+  // calculated so far reach the expensive level.
+  const fidelity_cascade<G> fc{ { { coarse, incalculable, .25, 1. },
+                                  { exact, incalculable, 1., 100. } } };
+  const fitness_db<G> fd{ fc, constraints_satisfied<G> };
+
+  const ranking_selection<G> rs{ fd, exponential_ranking_selection };
+  const variation<G> v{ Gaussian_mutation<G>(.6, 1. / dim),
+                        arithmetic_recombination<G> };
+  const auto p0 = random_population<constraints_satisfied<G>, G>;
+  const auto p1 = stochastic_universal_sampling<G>{ rs };
+  const auto p2 = adapter<G>(stochastic_universal_sampling<G>{ rs });
+  const auto tc = max_iterations_termination<G>(20);
+  evolution<G>(v, p0, p1, p2, tc, 20, 20, 1);
+
+  const G best = fd.rank_order()[0];
+  std::cout << "Best genotype: " << best << " (" << fd(best) << ")\n";
+  for (std::size_t i = 0; i < fc.size(); ++i) {
+    std::cout << "Level " << i << ": " << fc.evaluations(i) << " evaluations, "
+              << fc.passed(i) << " passed\n";
+  }
+  std::cout << "Saved cost: " << fc.saved_cost() << '\n';
+  assert(fc.evaluations(0) == fd.size());
+  assert(fc.evaluations(1) == fc.passed(0) && fc.evaluations(1) < fd.size());
+  assert(fc.find(1, best) == fd(best));
+
+  // Incalculable value never passes, even with default threshold; calculable
+  // values pass if they are among the best half of values so far.
+  const fitness_function<G> first = [](const G& g) {
+    return g.value(0) < 0 ? incalculable : g.value(0);
+  };
+  const fidelity_cascade<G> fc2{ { { first, incalculable, .5, 1. },
+                                   { exact, incalculable, 1., 1. } } };
+  G g = G::random();
+  for (const type x : { -1., 1., 3., 2., .5 }) {
+    g.value(0, x);
+    fc2(g);
+  }
+  assert(fc2.passed(0) == 3 && fc2.evaluations(1) == 3);
+}
@@ -38,4 +38,9 @@ main()
   }
   std::cout << "The best genotype is " << fd.rank_order()[0] << '.'
             << std::endl;
+  const std::size_t n = fd.size();
+  assert(fd.inserted(0).size() == n && fd.inserted(n).empty());
+  const auto g = G::random();
+  fd(g);
+  assert(fd.inserted(n).size() == 1 && fd.inserted(n)[0].first == g);
 }
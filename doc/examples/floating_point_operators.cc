@@ -0,0 +1,63 @@
+#include <cassert>
+#include <cstddef>
+#include <iostream>
+#include <numeric>
+#include <quile/quile.h>
+
+using namespace quile;
+
+template<typename G>
+G
+reference_Gaussian_mutation(const G& g, typename G::gene_t sigma, probability p)
+{
+  G res{ g };
+  const auto c = G::constraints();
+  for (std::size_t i = 0; i < G::size(); ++i) {
+    if (success(p)) {
+      res.value(i, c[i].clamp(g.value(i) + sigma * random_N(0., 1.)));
+    }
+  }
+  return res;
+}
+
+template<typename G>
+G
+reference_arithmetic_recombination(const G& g0, const G& g1)
+{
+  G res{};
+  for (std::size_t i = 0; i < G::size(); ++i) {
+    res.value(i, std::midpoint(g0.value(i), g1.value(i)));
+  }
+  return res;
+}
+
+template<typename T>
+void
+check()
+{
+  const std::size_t dim = 37;
+  static const auto d = uniform_domain<T, dim>(-1., +1.);
+  using G = genotype<g_floating_point<T, dim, &d>>;
+  for (int i = 0; i < 100; ++i) {
+    const G g0 = G::random();
+    const G g1 = G::random();
+    for (probability p : { 0., 0.3, 1. }) {
+      random_engine().seed(i);
+      const G h0 = Gaussian_mutation<G>(T{ 0.5 }, p)(g0).at(0);
+      random_engine().seed(i);
+      const G h1 = reference_Gaussian_mutation(g0, T{ 0.5 }, p);
+      assert(h0 == h1);
+    }
+    assert(arithmetic_recombination(g0, g1).at(0) ==
+           reference_arithmetic_recombination(g0, g1));
+  }
+}
+
+int
+main()
+{
+  check<float>();
+  check<double>();
+  check<long double>();
+  std::cout << "Vectorized kernels agree with gene-by-gene operators.\n";
+}
@@ -9,6 +9,7 @@ using p_type = quile::g_permutation<int, 42, 0>;
 static_assert(std::is_same_v<p_type::type, int>);
 static_assert(p_type::size() == 42);
 static_assert(p_type::constraints() == d);
+static_assert(p_type::lowest() == 0);
 
 static_assert(quile::is_g_permutation<p_type>::value);
 static_assert(!quile::is_g_permutation_v<decltype(d)>);
@@ -1,6 +1,8 @@
+#include <cassert>
 #include <cstddef>
 #include <iostream>
 #include <quile/quile.h>
+#include <sstream>
 
 int
 main()
@@ -29,4 +31,13 @@ main()
   const std::size_t np = 33;
   quile::genotype<quile::g_permutation<int, np, 0>> gp;
   std::cout << "permutation:    " << gp.random_reset() << '\n';
+
+  // Genotype printed to the stream can be read back.
+  std::stringstream ss{};
+  ss << gb << '\n' << gi << '\n' << gp << '\n';
+  decltype(gb) hb{};
+  decltype(gi) hi{};
+  decltype(gp) hp{};
+  ss >> hb >> hi >> hp;
+  assert(ss && hb == gb && hi == gi && hp == gp);
 }
@@ -0,0 +1,59 @@
+#include <cassert>
+#include <iostream>
+#include <quile/quile.h>
+
+using namespace quile;
+using type = double;
+const std::size_t dim = 4;
+static const auto d = uniform_domain<type, dim>(-1., +1.);
+using G = genotype<g_floating_point<type, dim, &d>>;
+
+int
+main()
+{
+  const G g0 = G::random();
+  const G g1 = G::random();
+
+  // In-place operators write into existing genotypes.
+  G c0{ g0 };
+  in_place_Gaussian_mutation<G>(.1, 1.)(c0);
+  std::cout << "Mutated genotype: " << c0 << '\n';
+  G c1{};
+  assert(in_place_arithmetic_recombination(g0, g1, c0, c1) == 1);
+  std::cout << "Child of arithmetic recombination: " << c0 << '\n';
+  assert(in_place_one_point_xover(g0, g1, c0, c1) == 2);
+
+  // Ordinary operators can be converted to in-place forms.
+  const auto m = in_place<G>(random_reset<G>(.5));
+  m(c0);
+  const auto r = in_place<G>(single_arithmetic_recombination<G>);
+  assert(r(g0, g1, c0, c1) == 2);
+
+  population<G> p{};
+  for (int i = 0; i < 8; ++i) {
+    p.push_back(G::random());
+  }
+
+  // Fused variation gives the same offspring for ordinary and in-place
+  // operators, as well as for type-erased and static variation.
+  const variation<G> v0{ Gaussian_mutation<G>(.1, .5), uniform_xover<G> };
+  const variation<G> v1{ in_place_Gaussian_mutation<G>(.1, .5),
+                         in_place_uniform_xover<G> };
+  const auto v2 = static_variation<G>(in_place_Gaussian_mutation<G>(.1, .5),
+                                      in_place_uniform_xover<G>);
+  random_engine().seed(7);
+  const auto p0 = v0(p);
+  random_engine().seed(7);
+  const auto p1 = v1(p);
+  random_engine().seed(7);
+  const auto p2 = v2(p);
+  assert(p0 == p1 && p1 == p2);
+
+  // Recombination producing one child halves the population.
+  const auto v3 = static_variation<G>(in_place_unary_identity<G>,
+                                      in_place_arithmetic_recombination<G>);
+  assert(v3(p).size() == p.size() / 2);
+  for (const auto& g : v3(p)) {
+    std::cout << g << '\n';
+  }
+}
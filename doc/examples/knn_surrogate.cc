@@ -0,0 +1,64 @@
+#include <cassert>
+#include <cstddef>
+#include <iostream>
+#include <quile/quile.h>
+
+using namespace quile;
+using namespace quile::test_functions;
+
+using type = double;
+const std::size_t dim = 4;
+const test_function<type, dim> fn = Rosenbrock<type, dim>;
+const auto d = fn.function_domain();
+using G = genotype<g_floating_point<type, dim, &d>>;
+
+using B = genotype<g_binary<32>>;
+
+int
+main()
+{
+  const fitness_function<G> ff = [](const G& g) { return -fn(g.data()); };
+  const fitness_db<G> fd{ ff, constraints_satisfied<G> };
+
+  // Predictions for genotypes of training set are exact.
+  const knn_surrogate<G> s0{ 3 };
+  const population<G> p{ G::random(), G::random(), G::random() };
+  fd(p);
+  s0.update(fd);
+  assert(s0.size() == p.size() && s0(p) == fd(p));
+
+  // Update adds only genotypes evaluated since previous update.
+  s0.update(fd);
+  assert(s0.size() == p.size());
+  fd(G::random());
+  s0.update(fd);
+  assert(s0.size() == p.size() + 1);
+
+  // Only half of offspring is evaluated in each generation.
+  const knn_surrogate<G> s{ 5 };
+  const ranking_selection<G> rs{ fd, exponential_ranking_selection };
+  const variation<G> v{ Gaussian_mutation<G>(.6, 1. / dim),
+                        arithmetic_recombination<G> };
+  const auto p0 = random_population<constraints_satisfied<G>, G>;
+  const auto p1 = stochastic_universal_sampling<G>{ rs };
+  const auto p2 = surrogate_screening<G>(
+    adapter<G>(stochastic_universal_sampling<G>{ rs }), fd, s, .5, 20);
+  const auto tc = max_iterations_termination<G>(20);
+  evolution<G>(v, p0, p1, p2, tc, 20, 20, 1);
+  const G best = fd.rank_order()[0];
+  std::cout << "Best genotype: " << best << " (" << fd(best) << ")\n"
+            << "Evaluations: " << fd.size() << '\n'
+            << "Mean absolute error of " << s.validated()
+            << " predictions: " << s.mean_absolute_error() << '\n';
+
+  // Binary genotypes: Hamming distance to nearest neighbor.
+  const fitness_db<B> fb{ [](const B& b) {
+                           return std::ranges::count(b, true);
+                         },
+                          constraints_satisfied<B> };
+  const knn_surrogate<B> sb{ 1 };
+  B b{};
+  fb(b);
+  sb.update(fb);
+  assert(sb(population<B>{ b.random_reset() })[0] == 0.);
+}
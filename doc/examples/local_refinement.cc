@@ -0,0 +1,59 @@
+#include <cassert>
+#include <cstddef>
+#include <iostream>
+#include <quile/quile.h>
+#include <utility>
+
+using namespace quile;
+using namespace quile::test_functions;
+
+using type = double;
+const std::size_t dim = 4;
+const test_function<type, dim> fn = Rosenbrock<type, dim>;
+const auto d = fn.function_domain();
+using G = genotype<g_floating_point<type, dim, &d>>;
+
+int
+main()
+{
+  const fitness_function<G> ff = [](const G& g) { return -fn(g.data()); };
+  const fitness_db<G> fd{ ff, constraints_satisfied<G> };
+
+  // Refinement never worsens refined genotypes.
+  const populate_2_fn<G> keep =
+    [](std::size_t, const population<G>& p, const population<G>&) {
+      return p;
+    };
+  const population<G> p{ G::random(), G::random(), G::random() };
+  const population<G> q = local_refinement<G>(keep, fd, 2, 5, .01)(3, p, {});
+  assert(q.size() == p.size());
+  for (std::size_t i = 0; i < p.size(); ++i) {
+    assert(fd(q[i]) >= fd(p[i]));
+  }
+
+  // Copies of genotype are refined once, so that the next distinct genotype is
+  // refined as well.
+  G a = G::random();
+  G b = G::random();
+  if (fd(a) < fd(b)) {
+    std::swap(a, b);
+  }
+  const population<G> r =
+    local_refinement<G>(keep, fd, 2, 5, .01)(3, population<G>{ a, a, b }, {});
+  assert((r[0] == a) != (r[1] == a));
+  assert(fd(r[2]) > fd(b));
+
+  // Refinement of two best genotypes in each generation (default parameters).
+  const ranking_selection<G> rs{ fd, exponential_ranking_selection };
+  const variation<G> v{ Gaussian_mutation<G>(.6, 1. / dim),
+                        arithmetic_recombination<G> };
+  const auto p0 = random_population<constraints_satisfied<G>, G>;
+  const auto p1 = stochastic_universal_sampling<G>{ rs };
+  const auto p2 =
+    local_refinement<G>(adapter<G>(stochastic_universal_sampling<G>{ rs }), fd);
+  const auto tc = max_iterations_termination<G>(10);
+  evolution<G>(v, p0, p1, p2, tc, 20, 20, 1);
+  const G best = fd.rank_order()[0];
+  std::cout << "Best genotype: " << best << " (" << fd(best) << ")\n"
+            << "Evaluations: " << fd.size() << '\n';
+}
@@ -0,0 +1,86 @@
+#include <bitset>
+#include <cassert>
+#include <cstddef>
+#include <iostream>
+#include <quile/quile.h>
+
+using namespace quile;
+
+const std::size_t n = 100;
+using G = genotype<g_binary<n>>;
+
+std::size_t
+popcount(const packed_chain<n>& p)
+{
+  std::size_t res{ 0 };
+  for (auto w : p) {
+    res += std::bitset<64>{ w }.count();
+  }
+  return res;
+}
+
+int
+main()
+{
+  const G g0 = G::random();
+  const G g1 = G::random();
+  auto p0 = pack(g0.data());
+  auto p1 = pack(g1.data());
+  assert(unpack<n>(p0) == g0.data());
+  assert(p0.size() == 2 && (p0[1] >> (n - 64)) == 0);
+
+  const auto m = segment_mask<n>(10, 70);
+  assert(popcount(m) == 60);
+  exchange(p0, p1, m);
+  for (std::size_t i = 0; i < n; ++i) {
+    const bool inside = 10 <= i && i < 70;
+    assert(unpack<n>(p0)[i] == (inside ? g1 : g0).value(i));
+    assert(unpack<n>(p1)[i] == (inside ? g0 : g1).value(i));
+  }
+
+  assert(popcount(segment_mask<n>(0, n)) == n);
+  assert(popcount(uniform_mask<n>()) <= n);
+  assert(popcount(sparse_mask<n>(0.)) == 0);
+  assert(popcount(sparse_mask<n>(1e-300)) == 0);
+  assert(popcount(sparse_mask<n>(1.)) == n);
+
+  auto p = pack(g0.data());
+  const auto fm = sparse_mask<n>(0.05);
+  flip(p, fm);
+  flip(p, pack(g0.data()));
+  assert(p == fm);
+  std::cout << "Flipped genes: " << popcount(fm) << '\n';
+
+  for (const auto& r : { recombination_fn<G>{ one_point_xover<G> },
+                         recombination_fn<G>{ two_point_xover<G> },
+                         recombination_fn<G>{ uniform_xover<G> } }) {
+    const auto c = r(g0, g1);
+    assert(c.size() == 2);
+    for (std::size_t i = 0; i < n; ++i) {
+      assert((c[0].value(i) == g0.value(i) && c[1].value(i) == g1.value(i)) ||
+             (c[0].value(i) == g1.value(i) && c[1].value(i) == g0.value(i)));
+    }
+    std::cout << c[0] << '\n' << c[1] << '\n';
+  }
+
+  // One-point crossover: first child is prefix of first parent followed by
+  // suffix of second parent.
+  for (int k = 0; k < 100; ++k) {
+    const auto c = one_point_xover<G>(g0, g1);
+    std::size_t cp = 0;
+    while (cp < n && c[0].value(cp) == g0.value(cp)) {
+      ++cp;
+    }
+    for (std::size_t i = cp; i < n; ++i) {
+      assert(c[0].value(i) == g1.value(i) && c[1].value(i) == g0.value(i));
+    }
+  }
+
+  const auto [h, changed] = traced_bit_flipping<G>(0.1)(g0);
+  std::size_t differences{ 0 };
+  for (std::size_t i = 0; i < n; ++i) {
+    differences += h.value(i) != g0.value(i);
+  }
+  assert(differences == changed.size());
+  std::cout << "Mutated genes: " << differences << '\n';
+}
@@ -0,0 +1,39 @@
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <iostream>
+#include <quile/quile.h>
+
+using namespace quile;
+using namespace quile::test_functions;
+using type = double;
+const std::size_t dim = 100;
+const std::size_t block = 10;
+
+int
+main()
+{
+  // Shifted sphere is invariant under rotation: f(x) = |x - o|^2.
+  const auto f = partially_separable<compile_time::sphere<type, block>, dim>(4);
+  std::cout << f.name() << '\n';
+  const auto o = f.p_min();
+  assert(f(o) < 1e-20);
+  const auto d = f.function_domain();
+  point<type, dim> x{};
+  for (std::size_t i = 0; i < dim; ++i) {
+    x[i] = random_U(d[i].min(), d[i].max());
+  }
+  type r = 0.;
+  for (std::size_t i = 0; i < dim; ++i) {
+    r += square(x[i] - o[i]);
+  }
+  assert(std::fabs(f(x) - r) <= 1e-9 * r);
+
+  // The same seed gives the same function.
+  const auto g0 =
+    partially_separable<compile_time::Rosenbrock<type, block>, dim>(10, 7);
+  const auto g1 =
+    partially_separable<compile_time::Rosenbrock<type, block>, dim>(10, 7);
+  assert(g0(x) == g1(x) && g0(g0.p_min()) < 1e-20);
+  std::cout << g0.name() << ": " << g0(x) << '\n';
+}
@@ -0,0 +1,179 @@
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <iostream>
+#include <quile/quile.h>
+
+using namespace quile;
+
+const std::size_t n = 40;
+using G = genotype<g_permutation<int, n, 0>>;
+using C = G::chain_t;
+
+std::array<std::array<double, 2>, n> cities{};
+
+double
+dist(int a, int b)
+{
+  return std::hypot(cities[a][0] - cities[b][0], cities[a][1] - cities[b][1]);
+}
+
+// Tour length with sign changed (fitness is maximized).
+fitness
+negated_length(const C& c)
+{
+  double res{ 0. };
+  for (std::size_t i = 0; i < n; ++i) {
+    res -= dist(c[i], c[(i + 1) % n]);
+  }
+  return res;
+}
+
+// Chain after moving segment of `l` genes starting at `i` after gene at `j`.
+C
+moved(const C& c, std::size_t i, std::size_t l, std::size_t j)
+{
+  C res{ c };
+  if (j >= i + l) {
+    std::rotate(std::begin(res) + i, std::begin(res) + i + l,
+                std::begin(res) + j + 1);
+  } else {
+    std::rotate(std::begin(res) + j + 1, std::begin(res) + i,
+                std::begin(res) + i + l);
+  }
+  return res;
+}
+
+int
+at(const C& c, std::size_t i)
+{
+  return c[(i + n) % n];
+}
+
+// O(1) fitness changes of local moves (old length minus new length).
+permutation_moves<G>
+tsp_moves()
+{
+  permutation_moves<G> res{};
+  res.two_opt = [](const C& c, std::size_t i, std::size_t j) {
+    if (i == 0 && j == n - 1) {
+      return 0.;
+    }
+    const int p = at(c, i - 1);
+    const int q = at(c, j + 1);
+    return dist(p, c[i]) + dist(c[j], q) - dist(p, c[j]) - dist(c[i], q);
+  };
+  res.or_opt = [](const C& c, std::size_t i, std::size_t l, std::size_t j) {
+    if (i == 0 && j == n - 1) {
+      return 0.;
+    }
+    const int a = at(c, i - 1);
+    const int s0 = c[i];
+    const int s1 = c[i + l - 1];
+    const int b = at(c, i + l);
+    const int x = c[j];
+    const int y = at(c, j + 1);
+    return dist(a, s0) + dist(s1, b) + dist(x, y) - dist(a, b) - dist(x, s0) -
+           dist(s1, y);
+  };
+  res.swap = [](const C& c, std::size_t i, std::size_t j) {
+    // Sum of lengths of edges incident to positions `i` and `j`.
+    const auto incident = [&](const C& d) {
+      double s = dist(at(d, i - 1), d[i]) + dist(d[i], at(d, i + 1)) +
+                 dist(at(d, j - 1), d[j]) + dist(d[j], at(d, j + 1));
+      if (j == i + 1 || (i == 0 && j == n - 1)) {
+        s -= dist(d[i], d[j]);
+      }
+      return s;
+    };
+    C d{ c };
+    std::swap(d[i], d[j]);
+    return incident(c) - incident(d);
+  };
+  return res;
+}
+
+int
+main()
+{
+  for (auto& x : cities) {
+    x = { random_U(0., 1.), random_U(0., 1.) };
+  }
+  auto moves = tsp_moves();
+
+  // Delta functions agree with full evaluation.
+  const G g = G::random();
+  const C c = g.data();
+  for (std::size_t i = 0; i < n; ++i) {
+    for (std::size_t j = i + 1; j < n; ++j) {
+      C d{ c };
+      std::swap(d[i], d[j]);
+      assert(std::fabs(moves.swap(c, i, j) -
+                       (negated_length(d) - negated_length(c))) < 1e-9);
+      d = c;
+      std::reverse(std::begin(d) + i, std::begin(d) + j + 1);
+      assert(std::fabs(moves.two_opt(c, i, j) -
+                       (negated_length(d) - negated_length(c))) < 1e-9);
+    }
+    for (std::size_t l = 1; l <= 3 && i + l <= n; ++l) {
+      for (std::size_t j = 0; j < n; ++j) {
+        if (j + 1 >= i && j < i + l) {
+          continue;
+        }
+        const C d{ moved(c, i, l, j) };
+        assert(std::fabs(moves.or_opt(c, i, l, j) -
+                         (negated_length(d) - negated_length(c))) < 1e-9);
+      }
+    }
+  }
+
+  // Full neighborhood: result is 2-opt local optimum.
+  const G h = permutation_local_search<G>(moves)(g).at(0);
+  std::cout << "Random tour length: " << -negated_length(g.data()) << '\n';
+  std::cout << "Locally optimal tour length: " << -negated_length(h.data())
+            << '\n';
+  assert(negated_length(h.data()) >= negated_length(g.data()));
+  for (std::size_t i = 0; i + 1 < n; ++i) {
+    for (std::size_t j = i + 2; j < n; ++j) {
+      assert(moves.two_opt(h.data(), i + 1, j) <= moves.min_gain);
+    }
+  }
+
+  // Candidate lists: 6 nearest cities.
+  moves.candidates.resize(n);
+  for (int a = 0; a < static_cast<int>(n); ++a) {
+    std::vector<int> v{};
+    for (int b = 0; b < static_cast<int>(n); ++b) {
+      if (b != a) {
+        v.push_back(b);
+      }
+    }
+    std::ranges::sort(v, {}, [a](int b) { return dist(a, b); });
+    moves.candidates[a].assign(std::begin(v), std::begin(v) + 6);
+  }
+  const G k = permutation_local_search<G>(moves)(g).at(0);
+  std::cout << "Tour length (candidate lists): " << -negated_length(k.data())
+            << '\n';
+  assert(negated_length(k.data()) >= negated_length(g.data()));
+
+  // Non-cyclic permutation: moving the first gene after the last one is a
+  // proper move too.
+  permutation_moves<G> to_end{};
+  to_end.or_opt = [](const C& c, std::size_t i, std::size_t l, std::size_t j) {
+    const auto last = [](const C& d) { return fitness(d[n - 1] == n - 1); };
+    return last(moved(c, i, l, j)) - last(c);
+  };
+  C e{};
+  for (std::size_t i = 0; i < n; ++i) {
+    e[i] = static_cast<int>((i + n - 1) % n);
+  }
+  assert(permutation_local_search<G>(to_end)(G{ e }).at(0).value(n - 1) ==
+         n - 1);
+
+  // Local search as mutation in variation.
+  const variation<G> v{ permutation_local_search<G>(moves, 10),
+                        cut_n_crossfill<G> };
+  std::cout << "Offspring: " << v(population<G>{ g, h }).size() << '\n';
+}
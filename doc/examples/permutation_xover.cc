@@ -0,0 +1,39 @@
+#include <cassert>
+#include <iostream>
+#include <quile/quile.h>
+
+int
+main()
+{
+  using namespace quile;
+  using G = genotype<g_permutation<int, 9, 1>>;
+
+  const auto g0 = G::random();
+  const auto g1 = G::random();
+  std::cout << "Parents:\n" << g0 << '\n' << g1 << '\n';
+
+  for (const auto& r : { recombination_fn<G>{ cut_n_crossfill<G> },
+                         recombination_fn<G>{ partially_mapped_xover<G> },
+                         recombination_fn<G>{ order_xover<G> },
+                         recombination_fn<G>{ cycle_xover<G> },
+                         recombination_fn<G>{ edge_xover<G> } }) {
+    const population<G> p = r(g0, g1);
+    assert(p.size() == 1 || p.size() == 2);
+    std::cout << "Offspring:\n";
+    for (const auto& g : p) {
+      assert(G::valid(g.data()));
+      std::cout << g << '\n';
+    }
+  }
+
+  // Recombination of identical parents gives identical offspring.
+  for (const auto& g : partially_mapped_xover<G>(g0, g0)) {
+    assert(g == g0);
+  }
+  for (const auto& g : order_xover<G>(g0, g0)) {
+    assert(g == g0);
+  }
+  for (const auto& g : cycle_xover<G>(g0, g0)) {
+    assert(g == g0);
+  }
+}
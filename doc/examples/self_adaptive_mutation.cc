@@ -0,0 +1,73 @@
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <iostream>
+#include <quile/quile.h>
+
+using namespace quile;
+
+using type = double;
+const std::size_t dim = 5;
+static const auto d0 = uniform_domain<type, dim>(-35., +35.);
+
+template<typename G>
+fitness
+negated_sphere(const G& g)
+{
+  fitness res{ 0. };
+  for (std::size_t i = 0; i < dim; ++i) {
+    res -= g.value(i) * g.value(i);
+  }
+  return res;
+}
+
+// (1, 10) evolution strategy; returns the last parent.
+template<typename G>
+G
+comma_es(const mutation_fn<G>& m, G parent, std::size_t generations)
+{
+  for (std::size_t i = 0; i < generations; ++i) {
+    population<G> children{};
+    for (std::size_t j = 0; j < 10; ++j) {
+      children.push_back(m(parent).at(0));
+    }
+    parent = *std::ranges::max_element(children, {}, negated_sphere<G>);
+  }
+  return parent;
+}
+
+int
+main()
+{
+  {
+    // n step sizes (one per object gene).
+    static const auto d = self_adaptive_variation_domain(d0, 1e-12);
+    using G = genotype<g_floating_point<type, 2 * dim, &d>>;
+    auto c = chain_min(d);
+    std::ranges::fill(c, 1.);
+    const G g{ c };
+    const mutation_fn<G> m = self_adaptive_mutation<G>(1., 1.);
+    assert(m(g).at(0) != g);
+    const G h = comma_es<G>(m, g, 500);
+    std::cout << "n-sigma: " << h << '\n';
+    for (std::size_t i = dim; i < 2 * dim; ++i) {
+      assert(h.value(i) < 1e-2);
+    }
+    assert(negated_sphere(h) > -1e-4);
+  }
+  {
+    // One step size.
+    static const auto d = one_sigma_self_adaptive_variation_domain(d0, 1e-12);
+    static_assert(d.size() == dim + 1);
+    using G = genotype<g_floating_point<type, dim + 1, &d>>;
+    auto c = chain_min(d);
+    std::ranges::fill(c, 1.);
+    const G g{ c };
+    const mutation_fn<G> m = one_sigma_self_adaptive_mutation<G>(1.);
+    assert(m(g).at(0) != g);
+    const G h = comma_es<G>(m, g, 500);
+    std::cout << "one-sigma: " << h << '\n';
+    assert(h.value(dim) < 1e-2);
+    assert(negated_sphere(h) > -1e-4);
+  }
+}
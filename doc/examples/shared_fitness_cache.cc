@@ -0,0 +1,57 @@
+#define QUILE_ENABLE_SHARED_MEMORY
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <iostream>
+#include <quile/quile.h>
+#include <string>
+#include <sys/wait.h>
+#include <unistd.h>
+
+using namespace quile;
+using namespace quile::test_functions;
+
+using type = double;
+const std::size_t dim = 3;
+const test_function<type, dim> fn = sphere<type, dim>;
+const auto d = fn.function_domain();
+using G = genotype<g_floating_point<type, dim, &d>>;
+
+std::atomic<std::size_t> calculations{ 0 };
+
+fitness
+ff(const G& g)
+{
+  ++calculations;
+  return -fn(g.data());
+}
+
+int
+main()
+{
+  const std::string name{ "/quile_example_" + std::to_string(::getpid()) };
+  const auto p = random_population<constraints_satisfied<G>, G>(100);
+
+  // Child process evaluates population with its own database...
+  if (const pid_t pid = ::fork(); pid == 0) {
+    const shared_fitness_cache<G> cache{ name, 1024 };
+    const fitness_db<G> fd{ cache.cached(ff), constraints_satisfied<G>, 1 };
+    fd(p);
+    return calculations == p.size() ? 0 : 1;
+  } else {
+    int status{};
+    ::waitpid(pid, &status, 0);
+    assert(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+  }
+
+  // ... and the parent process takes its results from shared memory.
+  const shared_fitness_cache<G> cache{ name, 1024 };
+  const fitness_db<G> fd{ cache.cached(ff), constraints_satisfied<G>, 1 };
+  const fitnesses fs{ fd(p) };
+  std::cout << "Cached values: " << cache.size() << '\n'
+            << "Calculations in parent process: " << calculations << '\n';
+  assert(calculations == 0 && cache.size() == p.size());
+  assert(fs[0] == -fn(p[0].data()) && cache.find(p[0]) == fs[0]);
+  assert(!cache.insert(p[0], 0.) && cache.find(G::random()) == std::nullopt);
+  shared_fitness_cache<G>::remove(name);
+}
@@ -0,0 +1,47 @@
+#include <cassert>
+#include <cstddef>
+#include <iostream>
+#include <quile/quile.h>
+
+using namespace quile;
+using namespace quile::test_functions;
+using type = double;
+const std::size_t dim = 4;
+using F = compile_time::Rosenbrock<type, dim>;
+static_assert(static_test_function<F>);
+
+// Domain of compile-time form can be used directly in genotype definition.
+using G = genotype<g_floating_point<type, dim, &F::function_domain>>;
+static_assert(G::uniform_domain);
+static_assert(F::p_min()[0] == 1.);
+
+// User-defined compile-time form of test function.
+struct shifted_sphere
+{
+  using type = double;
+  static constexpr std::size_t size() { return 2; }
+  static constexpr const char* name = "shifted sphere";
+  static constexpr domain<type, 2> function_domain =
+    uniform_domain<type, 2>(-5., 5.);
+  static constexpr point<type, 2> p_min() { return point<type, 2>{ 1., 2. }; }
+  static type value(const point<type, 2>& p)
+  {
+    return square(p[0] - 1.) + square(p[1] - 2.);
+  }
+};
+static_assert(static_test_function<shifted_sphere>);
+
+int
+main()
+{
+  // Fitness function calls compile-time form directly (no type erasure).
+  const fitness_function<G> ff = [](const G& g) { return -F::value(g.data()); };
+  const G g = G::random();
+  assert((ff(g) == -Rosenbrock<type, dim>(g.data())));
+  std::cout << F::name << " at " << g << ": " << F::value(g.data()) << '\n';
+
+  // Type-erased wrapper can be created from compile-time form.
+  const test_function<type, 2> tf{ shifted_sphere{} };
+  assert(tf(tf.p_min()) == 0.);
+  std::cout << tf.name() << " at p_min: " << tf(tf.p_min()) << '\n';
+}
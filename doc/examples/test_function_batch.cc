@@ -0,0 +1,88 @@
+#include <atomic>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <iostream>
+#include <quile/quile.h>
+#include <vector>
+
+using namespace quile;
+using namespace quile::test_functions;
+using type = double;
+const std::size_t dim = 10;
+static const auto d = sphere<type, dim>.function_domain();
+using G = genotype<g_floating_point<type, dim, &d>>;
+
+template<std::size_t N>
+void
+check(const test_function<type, N>& tf, std::size_t n)
+{
+  std::vector<point<type, N>> ps(n);
+  std::vector<type> xs(N * n);
+  const auto fd = tf.function_domain();
+  for (std::size_t i = 0; i < n; ++i) {
+    for (std::size_t j = 0; j < N; ++j) {
+      ps[i][j] = xs[j * n + i] = random_U(fd[j].min(), fd[j].max());
+    }
+  }
+  std::vector<type> aos(n);
+  std::vector<type> soa(n);
+  tf.batch(ps, aos);
+  tf.batch(xs, soa);
+  for (std::size_t i = 0; i < n; ++i) {
+    const type v = tf(ps[i]);
+    assert(std::fabs(aos[i] - v) <= 1e-12 * (1. + std::fabs(v)));
+    assert(std::fabs(soa[i] - v) <= 1e-12 * (1. + std::fabs(v)));
+  }
+  std::cout << tf.name() << ": " << n << " points checked\n";
+}
+
+int
+main()
+{
+  check(Ackley<type, dim>, 150);
+  check(Alpine<type, dim>, 150);
+  check(exponential<type, dim>, 150);
+  check(Rosenbrock<type, dim>, 150);
+  check(Schwefel<type, dim>, 150);
+  check(sphere<type, dim>, 150);
+  check(Booth<type>, 10);
+
+  // Fitness function values missing in database are calculated in batch.
+  std::atomic<std::size_t> calls{ 0 };
+  const fitness_function<G> f = [](const G& g) {
+    return -sphere<type, dim>(g.data());
+  };
+  const batch_fitness_function<G> bf = [&](const population<G>& p) {
+    ++calls;
+    std::vector<type> xs(dim * p.size());
+    for (std::size_t i = 0; i < p.size(); ++i) {
+      for (std::size_t j = 0; j < dim; ++j) {
+        xs[j * p.size() + i] = p[i].value(j);
+      }
+    }
+    fitnesses res(p.size());
+    sphere<type, dim>.batch(xs, res);
+    for (auto& x : res) {
+      x = -x;
+    }
+    return res;
+  };
+  const fitness_db<G> fd{ f, bf, constraints_satisfied<G>, 1 };
+  population<G> p{};
+  for (int i = 0; i < 20; ++i) {
+    p.push_back(G::random());
+  }
+  p.push_back(p[0]);
+  const fitnesses fs = fd(p);
+  assert(calls == 1 && fd.size() == 20);
+  for (std::size_t i = 0; i < p.size(); ++i) {
+    assert(std::fabs(fs[i] - f(p[i])) < 1e-9);
+  }
+  fd(p);
+  assert(calls == 1);
+
+  const fitness_db<G> fd2{ f, bf, constraints_satisfied<G>, 4 };
+  assert(fd2(p) == fs);
+  std::cout << "Batch calls: " << calls << '\n';
+}
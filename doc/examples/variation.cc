@@ -35,4 +35,21 @@ main()
   const auto p3 = v3(g0, g1);
   std::cout << p3[0] << '\n';
   std::cout << p3[1] << '\n';
+
+  // Concurrent variation: result depends only on the seed of random_engine(),
+  // also when population is varied by one thread.
+  population<G> p4{};
+  for (int i = 0; i < 100; ++i) {
+    p4.push_back(G::random());
+  }
+  const variation<G> v4{ swap_mutation<G>, cut_n_crossfill<G>, 4 };
+  const variation<G> v5{ swap_mutation<G>, cut_n_crossfill<G>, 2 };
+  const variation<G> v6{ swap_mutation<G>, cut_n_crossfill<G> };
+  random_engine().seed(42);
+  const auto p5 = v4(p4);
+  random_engine().seed(42);
+  const auto p6 = v5(p4);
+  random_engine().seed(42);
+  const auto p7 = v6(p4);
+  assert(p5.size() == p4.size() && p5 == p6 && p5 == p7);
 }
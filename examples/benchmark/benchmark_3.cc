@@ -19,11 +19,11 @@ const type linear_s = LINEAR_S;
 const type eps_f = EPS_F;
 const type eps_x = EPS_X;
 
-const test_function<type, dim> benchmark_function = TEST_FN;
-const auto fn_domain = benchmark_function.function_domain();
-const auto p_min = benchmark_function.p_min();
-using G = genotype<g_floating_point<type, dim, &fn_domain>>;
-static_assert(dim == fn_domain.size());
+using F = compile_time::TEST_FN;
+const test_function<type, dim> benchmark_function{ F{} };
+const auto p_min = F::p_min();
+using G = genotype<g_floating_point<type, dim, &F::function_domain>>;
+static_assert(dim == F::function_domain.size());
 
 template<typename T, std::size_t N>
 T thinnest_dimension(const domain<T, N>& d) {
@@ -85,15 +85,24 @@ int main()
 				recombination_probability)
   };
   const auto f = [](const point<type, dim>& p) {
-    return -benchmark_function(p);
+    return -F::value(p);
   };
   const fitness_function<G> ff = [&](const G& g) { return f(phenotype(g)); };
-  const fitness_db<G> fd{ ff, constraints_satisfied<G>, 1 };
+  const batch_fitness_function<G> bf = [](const population<G>& p) {
+    std::vector<point<type, dim>> ps{};
+    std::ranges::transform(p, std::back_inserter(ps), phenotype<G>);
+    std::vector<type> vs(ps.size());
+    benchmark_function.batch(ps, vs);
+    fitnesses res{};
+    std::ranges::transform(vs, std::back_inserter(res), std::negate{});
+    return res;
+  };
+  const fitness_db<G> fd{ ff, bf, constraints_satisfied<G>, 1 };
   const auto sel{ get_selection<G>(fd) };
   const auto p0 = random_population<constraints_satisfied<G>, G>;
   const auto p1 = stochastic_universal_sampling<G>{ sel };
   const auto p2 = adapter<G>(stochastic_universal_sampling<G>{ sel });
-  const fitness tr = f(benchmark_function.p_min());
+  const fitness tr = f(p_min);
   const auto tc_1 = fn_and(fitness_threshold_termination<G>(fd, tr, eps_f),
                            position_threshold_termination<G>(p_min, eps_x));
   const auto tc_2 = max_iterations_termination<G>(max_generations);
@@ -0,0 +1,124 @@
+// Time of binary crossover and mutation kernels as a function of chain length
+// - representation: binary, unpacked (one Boolean per gene) and packed (64
+//   genes per word)
+// - operators: one-point, two-point and uniform crossover, bit-flipping
+//   mutation with gene mutation probability 1/N
+//
+// Example compilation command:
+//
+//   g++ -Wall -Wextra -pedantic -O3 -std=c++20 -pthread -DNDEBUG -I../../
+//     binary_operators.cc -o binary_operators
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <quile/quile.h>
+
+using namespace quile;
+
+namespace {
+
+template<typename F>
+double
+ns_per_call(F f, std::size_t repetitions)
+{
+  const auto t0 = std::chrono::steady_clock::now();
+  for (std::size_t i = 0; i < repetitions; ++i) {
+    f();
+  }
+  const auto t1 = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::nano>(t1 - t0).count() /
+         repetitions;
+}
+
+template<std::size_t N>
+void
+measure()
+{
+  const std::size_t repetitions = std::max<std::size_t>(10, 10000000 / N);
+  const probability p = 1. / N;
+
+  // Gene-by-gene operators on unpacked chains (reference).
+  auto c0 = std::make_unique<chain<bool, N>>();
+  auto c1 = std::make_unique<chain<bool, N>>();
+  for (std::size_t i = 0; i < N; ++i) {
+    (*c0)[i] = random_U(false, true);
+    (*c1)[i] = random_U(false, true);
+  }
+  const double one_point = ns_per_call(
+    [&] {
+      const auto cp = random_U<std::size_t>(0, N - 1);
+      for (std::size_t i = cp; i < N; ++i) {
+        std::swap((*c0)[i], (*c1)[i]);
+      }
+    },
+    repetitions);
+  const double uniform = ns_per_call(
+    [&] {
+      for (std::size_t i = 0; i < N; ++i) {
+        if (success(.5)) {
+          std::swap((*c0)[i], (*c1)[i]);
+        }
+      }
+    },
+    repetitions);
+  const double flipping = ns_per_call(
+    [&] {
+      for (std::size_t i = 0; i < N; ++i) {
+        if (success(p)) {
+          (*c0)[i] = !(*c0)[i];
+        }
+      }
+    },
+    repetitions);
+
+  // Word-level kernels on packed chains.
+  auto p0 = std::make_unique<packed_chain<N>>(pack(*c0));
+  auto p1 = std::make_unique<packed_chain<N>>(pack(*c1));
+  const double packed_one_point = ns_per_call(
+    [&] {
+      const auto cp = random_U<std::size_t>(0, N - 1);
+      exchange(*p0, *p1, segment_mask<N>(cp, N));
+    },
+    repetitions);
+  const double packed_two_point = ns_per_call(
+    [&] {
+      const auto a = random_U<std::size_t>(0, N - 1);
+      const auto b = random_U<std::size_t>(0, N - 1);
+      exchange(*p0, *p1, segment_mask<N>(std::min(a, b), std::max(a, b) + 1));
+    },
+    repetitions);
+  const double packed_uniform = ns_per_call(
+    [&] { exchange(*p0, *p1, uniform_mask<N>()); }, repetitions);
+  const double packed_flipping =
+    ns_per_call([&] { flip(*p0, sparse_mask<N>(p)); }, repetitions);
+
+  std::cout << std::setw(8) << N << std::fixed << std::setprecision(1);
+  for (double t : { one_point,
+                    uniform,
+                    flipping,
+                    packed_one_point,
+                    packed_two_point,
+                    packed_uniform,
+                    packed_flipping }) {
+    std::cout << std::setw(12) << t;
+  }
+  std::cout << '\n';
+}
+
+} // anonymous namespace
+
+int
+main()
+{
+  std::cout << "# Time per operation [ns]\n"
+            << "#      N   one_point     uniform    flipping"
+            << "  p_one_poin  p_two_poin   p_uniform  p_flipping\n";
+  measure<1000>();
+  measure<10000>();
+  measure<100000>();
+  measure<1000000>();
+}
@@ -0,0 +1,125 @@
+// Throughput of hash map shared by threads as a function of number of threads
+// - workload: side table keyed by genotype (like file names of evenstar),
+//   each thread performs lookups and, with probability 0.1, assignments of
+//   random keys of fixed set
+// - variants: `std::unordered_map` guarded by single mutex,
+//   `quile::concurrent_unordered_map` with one shard (single shared mutex) and
+//   with default number of shards
+//
+// Example compilation command:
+//
+//   g++ -Wall -Wextra -pedantic -O3 -std=c++20 -pthread -DNDEBUG -I../../
+//     concurrent_map.cc -o concurrent_map
+
+#include <chrono>
+#include <cstddef>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <optional>
+#include <quile/quile.h>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+using namespace quile;
+
+namespace {
+
+using G = genotype<g_binary<64>>;
+
+const std::size_t keys = 10000;
+const std::size_t operations = 200000;
+const double write_probability = .1;
+
+class locked_unordered_map
+{
+public:
+  void insert_or_assign(const G& g, std::size_t t)
+  {
+    const std::lock_guard<std::mutex> lg{ m_ };
+    map_.insert_or_assign(g, t);
+  }
+
+  std::optional<std::size_t> find(const G& g) const
+  {
+    const std::lock_guard<std::mutex> lg{ m_ };
+    const auto it = map_.find(g);
+    return it == map_.end() ? std::nullopt
+                            : std::optional<std::size_t>{ it->second };
+  }
+
+private:
+  mutable std::mutex m_{};
+  std::unordered_map<G, std::size_t> map_{};
+};
+
+// Mean time of one operation [ns] (wall time of all threads divided by total
+// number of operations).
+template<typename Map>
+double
+ns_per_operation(Map& map, const population<G>& p, std::size_t threads)
+{
+  std::vector<std::vector<std::size_t>> indices(threads);
+  std::vector<std::vector<bool>> writes(threads);
+  for (std::size_t t = 0; t < threads; ++t) {
+    for (std::size_t i = 0; i < operations / threads; ++i) {
+      indices[t].push_back(random_U<std::size_t>(0, keys - 1));
+      writes[t].push_back(random_U(0., 1.) < write_probability);
+    }
+  }
+  std::vector<std::size_t> sinks(threads, 0);
+  const auto t0 = std::chrono::steady_clock::now();
+  std::vector<std::jthread> ts{};
+  for (std::size_t t = 0; t < threads; ++t) {
+    ts.emplace_back([&, t]() {
+      for (std::size_t i = 0; i < indices[t].size(); ++i) {
+        const auto& g = p[indices[t][i]];
+        if (writes[t][i]) {
+          map.insert_or_assign(g, i);
+        } else {
+          sinks[t] += map.find(g).value_or(0);
+        }
+      }
+    });
+  }
+  ts.clear();
+  const auto t1 = std::chrono::steady_clock::now();
+  if (std::reduce(sinks.begin(), sinks.end()) == 0) {
+    std::cout << "Nothing found!\n";
+  }
+  return std::chrono::duration<double, std::nano>(t1 - t0).count() /
+         operations;
+}
+
+template<typename Map>
+double
+measure(const population<G>& p, std::size_t threads, auto... args)
+{
+  Map map{ args... };
+  for (std::size_t i = 0; i < keys; ++i) {
+    map.insert_or_assign(p[i], i);
+  }
+  return ns_per_operation(map, p, threads);
+}
+
+} // anonymous namespace
+
+int
+main()
+{
+  const auto p = random_population<constraints_satisfied<G>, G>(keys);
+  std::cout << std::setw(10) << "# threads" << std::setw(36)
+            << "time per operation [ns]" << '\n'
+            << std::setw(10) << "#" << std::setw(12) << "mutex"
+            << std::setw(12) << "1 shard" << std::setw(12) << "64 shards"
+            << '\n';
+  for (const std::size_t threads : { 1, 2, 4, 8, 16 }) {
+    using map = concurrent_unordered_map<G, std::size_t>;
+    std::cout << std::setw(10) << threads << std::fixed
+              << std::setprecision(1) << std::setw(12)
+              << measure<locked_unordered_map>(p, threads) << std::setw(12)
+              << measure<map>(p, threads, std::size_t{ 1 }) << std::setw(12)
+              << measure<map>(p, threads) << '\n';
+  }
+}
@@ -0,0 +1,94 @@
+// Makespan of concurrent fitness function calculations for population as a
+// function of population size
+// - workload: evaluation time (sleep) cubic in number of ones of binary
+//   genotype, i.e. heterogeneous like DFT calculations of structures with
+//   different number of atoms
+// - variants: FIFO order, longest predicted processing time first (LPT) with
+//   single cost feature equal to number of ones, i.e. descending order of
+//   number of ones; lower bound max(total / threads, longest calculation)
+//
+// Example compilation command:
+//
+//   g++ -Wall -Wextra -pedantic -O3 -std=c++20 -pthread -DNDEBUG -I../../
+//     evaluation_scheduling.cc -o evaluation_scheduling
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <iomanip>
+#include <iostream>
+#include <quile/quile.h>
+#include <thread>
+#include <vector>
+
+using namespace quile;
+
+namespace {
+
+using G = genotype<g_binary<32>>;
+
+const unsigned int threads = 8;
+const std::size_t repetitions = 5;
+
+double
+ones(const G& g)
+{
+  return std::ranges::count(g, true);
+}
+
+double
+ms(const G& g)
+{
+  return .001 * ones(g) * ones(g) * ones(g);
+}
+
+fitness
+slow_onemax(const G& g)
+{
+  std::this_thread::sleep_for(std::chrono::duration<double, std::milli>(ms(g)));
+  return ones(g);
+}
+
+void
+measure(std::size_t sz)
+{
+  double fifo{ 0. };
+  double lpt{ 0. };
+  double bound{ 0. };
+  for (std::size_t i = 0; i < repetitions; ++i) {
+    const auto p = random_population<constraints_satisfied<G>, G>(sz);
+    const fitness_db<G> fd0{ slow_onemax, constraints_satisfied<G>, threads };
+    fd0(p);
+    fifo += fd0.last_schedule().makespan;
+    const fitness_db<G> fd1{ slow_onemax, constraints_satisfied<G>, threads };
+    fd1.cost_features(
+      [](const G& g) { return std::vector<double>{ ones(g) }; });
+    fd1(p);
+    lpt += fd1.last_schedule().makespan;
+    double total{ 0. };
+    double longest{ 0. };
+    for (const auto& g : p) {
+      total += ms(g) / 1000;
+      longest = std::max(longest, ms(g) / 1000);
+    }
+    bound += std::max(total / threads, longest);
+  }
+  std::cout << std::setw(8) << sz << std::fixed << std::setprecision(1)
+            << std::setw(12) << 1000 * fifo / repetitions << std::setw(12)
+            << 1000 * lpt / repetitions << std::setw(12)
+            << 1000 * bound / repetitions << '\n';
+}
+
+} // anonymous namespace
+
+int
+main()
+{
+  std::cout << std::setw(8) << "# size" << std::setw(36)
+            << "makespan [ms]" << '\n'
+            << std::setw(8) << "#" << std::setw(12) << "FIFO" << std::setw(12)
+            << "LPT" << std::setw(12) << "bound" << '\n';
+  for (const std::size_t sz : { 16, 32, 64, 128 }) {
+    measure(sz);
+  }
+}
@@ -0,0 +1,96 @@
+// Evaluations per second of large-scale test functions versus dimension
+// - test functions: shifted, partially separable (half of groups rotated)
+//   sphere, Rosenbrock and Ackley built from groups of 50 variables
+// - variants: direct test function call, evaluation through fitness_db
+//   (includes genotype hashing and database insertion)
+//
+// Example compilation command:
+//
+//   g++ -Wall -Wextra -pedantic -O3 -std=c++20 -pthread -DNDEBUG -I../../
+//     large_scale.cc -o large_scale
+
+#include <chrono>
+#include <cstddef>
+#include <iomanip>
+#include <iostream>
+#include <quile/quile.h>
+#include <vector>
+
+using namespace quile;
+using namespace quile::test_functions;
+
+namespace {
+
+using type = double;
+const std::size_t block = 50;
+const std::size_t population_sz = 200;
+
+template<typename F>
+double
+per_second(F f, std::size_t evaluations)
+{
+  const auto t0 = std::chrono::steady_clock::now();
+  f();
+  const auto t1 = std::chrono::steady_clock::now();
+  return evaluations / std::chrono::duration<double>(t1 - t0).count();
+}
+
+template<template<typename, std::size_t> typename B, std::size_t N>
+void
+measure()
+{
+  using F = B<type, block>;
+  static constexpr domain<type, N> d = []() {
+    domain<type, N> res{};
+    std::ranges::fill(res, F::function_domain[0]);
+    return res;
+  }();
+  using G = genotype<g_floating_point<type, N, &d>>;
+  const auto tf = partially_separable<F, N>(N / block / 2);
+  population<G> p{};
+  for (std::size_t i = 0; i < population_sz; ++i) {
+    p.push_back(G::random());
+  }
+  std::vector<point<type, N>> ps(p.size());
+  for (std::size_t i = 0; i < p.size(); ++i) {
+    std::ranges::copy(p[i].data(), std::begin(ps[i]));
+  }
+  type sink = 0.;
+  const double direct = per_second(
+    [&]() {
+      for (const auto& x : ps) {
+        sink += tf(x);
+      }
+    },
+    ps.size());
+  const fitness_db<G> fd{ [&](const G& g) { return -tf(g.data()); },
+                          constraints_satisfied<G>,
+                          1 };
+  const double database = per_second([&]() { fd(p); }, p.size());
+  std::cout << std::setw(8) << N << std::setw(12) << F::name << std::fixed
+            << std::setprecision(0) << std::setw(18) << direct
+            << std::setw(18) << database << (sink < 0. ? " !" : "") << '\n';
+}
+
+template<std::size_t N>
+void
+measure_all()
+{
+  measure<compile_time::sphere, N>();
+  measure<compile_time::Rosenbrock, N>();
+  measure<compile_time::Ackley, N>();
+}
+
+} // anonymous namespace
+
+int
+main()
+{
+  std::cout << std::setw(8) << "# N" << std::setw(12) << "function"
+            << std::setw(18) << "direct [1/s]" << std::setw(18)
+            << "fitness_db [1/s]" << '\n';
+  measure_all<1000>();
+  measure_all<2000>();
+  measure_all<5000>();
+  measure_all<10000>();
+}
@@ -0,0 +1,90 @@
+// Expected number of fitness function evaluations needed to reach the optimum
+// with and without memetic local refinement
+// - representation: floating-point
+// - operators: Gaussian mutation, arithmetic recombination
+// - selection: exponential ranking selection with stochastic universal
+//   sampling
+// - local refinement: pattern search with default parameters (2 best
+//   genotypes, 20 iterations per generation)
+// - test functions: Rosenbrock (2D), Matyas, Miele-Cantrell, sphere (4D)
+// - measure: evaluations of all runs divided by number of successful runs
+//   (expected running time), i.e. failed runs are not ignored
+//
+// Example compilation command:
+//
+//   g++ -Wall -Wextra -pedantic -O3 -std=c++20 -pthread -DNDEBUG -I../../
+//     local_refinement.cc -o local_refinement
+
+#include <cstddef>
+#include <iomanip>
+#include <iostream>
+#include <quile/quile.h>
+
+using namespace quile;
+using namespace quile::test_functions;
+
+namespace {
+
+const std::size_t runs = 20;
+const std::size_t max_generations = 2000;
+const fitness eps_f = 1e-3;
+
+template<std::size_t N, const test_function<double, N>* F>
+void
+measure()
+{
+  static const auto d = F->function_domain();
+  using G = genotype<g_floating_point<double, N, &d>>;
+  const double sigma = .01 * (d[0].max() - d[0].min());
+  for (bool refinement : { false, true }) {
+    std::size_t successes{ 0 };
+    std::size_t evaluations{ 0 };
+    for (std::size_t r = 0; r < runs; ++r) {
+      const fitness_function<G> ff = [](const G& g) { return -(*F)(g.data()); };
+      const fitness_db<G> fd{ ff, constraints_satisfied<G>, 1 };
+      const ranking_selection<G> rs{ fd, exponential_ranking_selection };
+      const variation<G> v{ Gaussian_mutation<G>(sigma, 1. / N),
+                            arithmetic_recombination<G> };
+      const auto p0 = random_population<constraints_satisfied<G>, G>;
+      const auto p1 = stochastic_universal_sampling<G>{ rs };
+      const populate_2_fn<G> p2 =
+        adapter<G>(stochastic_universal_sampling<G>{ rs });
+      const fitness tr = -(*F)(F->p_min());
+      const auto tc =
+        fn_or(fitness_threshold_termination<G>(fd, tr, eps_f),
+              max_iterations_termination<G>(max_generations));
+      evolution<G>(v,
+                   p0,
+                   p1,
+                   refinement ? local_refinement<G>(p2, fd) : p2,
+                   tc,
+                   50,
+                   50,
+                   1);
+      evaluations += fd.size();
+      if (fd(fd.rank_order()[0]) >= tr - eps_f) {
+        ++successes;
+      }
+    }
+    std::cout << std::setw(16) << F->name() << std::setw(12)
+              << (refinement ? "yes" : "no") << std::setw(12) << successes
+              << std::setw(16);
+    if (successes) {
+      std::cout << evaluations / successes << '\n';
+    } else {
+      std::cout << "--" << '\n';
+    }
+  }
+}
+
+} // anonymous namespace
+
+int
+main()
+{
+  std::cout << "#       function  refinement   successes  evaluations\n";
+  measure<2, &Rosenbrock<double, 2>>();
+  measure<2, &Matyas<double>>();
+  measure<4, &Miele_Cantrell<double>>();
+  measure<4, &sphere<double, 4>>();
+}
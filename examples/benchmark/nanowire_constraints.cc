@@ -0,0 +1,127 @@
+// Time of nanowire constraint checks as a function of number of atoms in unit
+// cell
+// - constraints: minimum distance of atoms (with periodic images along
+//   nanowire axis) and connectivity of atoms of unit cell and its image
+// - variants: all pairs of atoms, cell list (evenstar implementation, which
+//   checks all pairs in place below detail::cell_list_min_atoms atoms)
+// - geometry: zigzag chain of boron atoms satisfying both constraints, so
+//   that no check finishes early
+//
+// Example compilation command:
+//
+//   g++ -Wall -Wextra -pedantic -O3 -std=c++20 -pthread -DNDEBUG -I../../
+//     nanowire_constraints.cc ../evenstar/src/nanowire.cc ../common/pwx.cc
+//     -o nanowire_constraints
+
+#include "../evenstar/src/nanowire.h"
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <iomanip>
+#include <iostream>
+
+using namespace evenstar;
+
+namespace {
+
+const double min_distance = 1.54;
+const double max_distance = 2.10;
+const double dz = .8;
+const double dy = 1.6;
+
+template<typename F>
+double
+us_per_call(F f)
+{
+  const std::size_t repetitions = 100;
+  bool sink = true;
+  const auto t0 = std::chrono::steady_clock::now();
+  for (std::size_t i = 0; i < repetitions; ++i) {
+    sink = f() && sink;
+  }
+  const auto t1 = std::chrono::steady_clock::now();
+  if (!sink) {
+    std::cout << "Constraint not satisfied!\n";
+  }
+  return std::chrono::duration<double, std::micro>(t1 - t0).count() /
+         repetitions;
+}
+
+double
+distance(const pwx_position& p, const pwx_position& q, double shift)
+{
+  return std::hypot(q.x - p.x, q.y - p.y, q.z + shift - p.z);
+}
+
+bool
+pairwise_not_too_close(const pwx_positions& ps, double h)
+{
+  for (std::size_t i = 0; i < ps.size(); ++i) {
+    for (std::size_t j = i + 1; j < ps.size(); ++j) {
+      for (const double shift : { -h, 0., h }) {
+        if (distance(ps[i], ps[j], shift) < min_distance) {
+          return false;
+        }
+      }
+    }
+  }
+  return h >= min_distance;
+}
+
+template<std::size_t N>
+bool
+pairwise_connected(const pwx_positions& ps, double h)
+{
+  const std::size_t n{ ps.size() };
+  union_find<2 * N> uf{ 2 * n };
+  for (std::size_t i = 0; i < 2 * n; ++i) {
+    for (std::size_t j = i + 1; j < 2 * n; ++j) {
+      const double shift{ (j < n ? 0. : h) - (i < n ? 0. : h) };
+      if (distance(ps[i % n], ps[j % n], shift) <= max_distance) {
+        uf.unite(i, j);
+      }
+    }
+  }
+  return uf.components() == 1;
+}
+
+template<std::size_t N>
+void
+measure()
+{
+  pwx_positions ps{};
+  for (std::size_t i = 0; i < N; ++i) {
+    ps.push_back(pwx_position{ "B", 0., i % 2 ? dy : 0., i * dz });
+  }
+  const double h{ N * dz };
+  std::cout << std::setw(8) << N << std::fixed << std::setprecision(2)
+            << std::setw(12)
+            << us_per_call([&]() { return pairwise_not_too_close(ps, h); })
+            << std::setw(12) << us_per_call([&]() {
+                 return atoms_not_too_close_pbc(ps, h, min_distance);
+               })
+            << std::setw(12)
+            << us_per_call([&]() { return pairwise_connected<N>(ps, h); })
+            << std::setw(12) << us_per_call([&]() {
+                 return all_atoms_connected_pbc<N>(ps, h, max_distance);
+               })
+            << '\n';
+}
+
+} // anonymous namespace
+
+int
+main()
+{
+  std::cout << std::setw(8) << "# atoms" << std::setw(24) << "too close [us]"
+            << std::setw(24) << "connected [us]" << '\n'
+            << std::setw(8) << "#" << std::setw(12) << "pairwise"
+            << std::setw(12) << "cell list" << std::setw(12) << "pairwise"
+            << std::setw(12) << "cell list" << '\n';
+  measure<10>();
+  measure<50>();
+  measure<100>();
+  measure<200>();
+  measure<500>();
+  measure<1000>();
+}
@@ -0,0 +1,97 @@
+// Time of permutation recombination operators as a function of genotype length
+// - representation: permutation
+// - operators: cut-and-crossfill (quadratic reference and linear), PMX, order,
+//   cycle and edge crossover
+//
+// Example compilation command:
+//
+//   g++ -Wall -Wextra -pedantic -O3 -std=c++20 -pthread -DNDEBUG -I../../
+//     permutation_xover.cc -o permutation_xover
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <iterator>
+#include <quile/quile.h>
+#include <string>
+
+using namespace quile;
+
+namespace {
+
+// Cut-and-crossfill implementation preceding linear one (for reference).
+template<typename G>
+requires permutation_chromosome<G> population<G>
+quadratic_cut_n_crossfill(const G& g0, const G& g1)
+{
+  const auto f = [cp = random_U<std::size_t>(1, G::size() - 1)](const G& g,
+                                                                auto d) {
+    auto it = std::begin(d);
+    std::advance(it, cp);
+    for (auto x : g) {
+      if (std::find(std::begin(d), it, x) == it) {
+        *it++ = x;
+      }
+    }
+    return d;
+  };
+  return population<G>{ G{ f(g1, g0.data()) }, G{ f(g0, g1.data()) } };
+}
+
+template<typename G>
+double
+ns_per_child(const recombination_fn<G>& r, std::size_t repetitions)
+{
+  const auto g0 = G::random();
+  const auto g1 = G::random();
+  std::size_t children = 0;
+  const auto t0 = std::chrono::steady_clock::now();
+  for (std::size_t i = 0; i < repetitions; ++i) {
+    children += r(g0, g1).size();
+  }
+  const auto t1 = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::nano>(t1 - t0).count() / children;
+}
+
+template<std::size_t N>
+void
+measure()
+{
+  using G = genotype<g_permutation<int, N, 0>>;
+  const std::size_t repetitions = std::max<std::size_t>(1, 1000000 / N);
+  std::cout << std::setw(8) << N;
+  for (const auto& r : { recombination_fn<G>{ cut_n_crossfill<G> },
+                         recombination_fn<G>{ partially_mapped_xover<G> },
+                         recombination_fn<G>{ order_xover<G> },
+                         recombination_fn<G>{ cycle_xover<G> },
+                         recombination_fn<G>{ edge_xover<G> } }) {
+    std::cout << std::setw(14) << std::fixed << std::setprecision(1)
+              << ns_per_child<G>(r, repetitions);
+  }
+  if constexpr (N <= 10000) {
+    std::cout << std::setw(14)
+              << ns_per_child<G>(quadratic_cut_n_crossfill<G>, repetitions);
+  } else {
+    std::cout << std::setw(14) << "--";
+  }
+  std::cout << '\n';
+}
+
+} // anonymous namespace
+
+int
+main()
+{
+  std::cout << "# Time per child [ns]\n"
+            << "#      N  cut_n_crossf           PMX            OX"
+            << "         cycle          edge  quadratic_cnc\n";
+  measure<8>();
+  measure<64>();
+  measure<512>();
+  measure<4096>();
+  measure<10000>();
+  measure<100000>();
+}
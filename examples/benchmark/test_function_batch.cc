@@ -0,0 +1,88 @@
+// Time of test function evaluation per point
+// - test functions: Ackley, Alpine, exponential, Rosenbrock, Schwefel, sphere
+// - variants: one call per point (type-erased and compile-time form), batch
+//   evaluation of points stored point-wise (AoS) and coordinate-wise (SoA)
+//
+// Example compilation command:
+//
+//   g++ -Wall -Wextra -pedantic -O3 -std=c++20 -pthread -DNDEBUG -I../../
+//     test_function_batch.cc -o test_function_batch
+
+#include <chrono>
+#include <cstddef>
+#include <iomanip>
+#include <iostream>
+#include <quile/quile.h>
+#include <vector>
+
+using namespace quile;
+using namespace quile::test_functions;
+
+namespace {
+
+using type = double;
+const std::size_t dim = 30;
+const std::size_t n = 10000;
+const std::size_t repetitions = 20;
+
+template<typename F>
+double
+ns_per_point(F f)
+{
+  const auto t0 = std::chrono::steady_clock::now();
+  for (std::size_t i = 0; i < repetitions; ++i) {
+    f();
+  }
+  const auto t1 = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::nano>(t1 - t0).count() /
+         (repetitions * n);
+}
+
+template<typename F>
+void
+measure()
+{
+  const test_function<type, dim> tf{ F{} };
+  std::vector<point<type, dim>> ps(n);
+  std::vector<type> xs(dim * n);
+  const auto d = tf.function_domain();
+  for (std::size_t i = 0; i < n; ++i) {
+    for (std::size_t j = 0; j < dim; ++j) {
+      ps[i][j] = xs[j * n + i] = random_U(d[j].min(), d[j].max());
+    }
+  }
+  std::vector<type> res(n);
+  const double scalar = ns_per_point([&] {
+    for (std::size_t i = 0; i < n; ++i) {
+      res[i] = tf(ps[i]);
+    }
+  });
+  const double inlined = ns_per_point([&] {
+    for (std::size_t i = 0; i < n; ++i) {
+      res[i] = F::value(ps[i]);
+    }
+  });
+  const double aos = ns_per_point([&] { tf.batch(ps, res); });
+  const double soa = ns_per_point([&] { tf.batch(xs, res); });
+  std::cout << std::setw(12) << std::left << tf.name() << std::right
+            << std::fixed << std::setprecision(1) << std::setw(10) << scalar
+            << std::setw(10) << inlined << std::setw(10) << aos << std::setw(10)
+            << soa << '\n';
+}
+
+} // anonymous namespace
+
+int
+main()
+{
+  std::cout << std::setw(12) << std::left << "# function" << std::right
+            << std::setw(10) << "scalar" << std::setw(10) << "static"
+            << std::setw(10) << "AoS" << std::setw(10) << "SoA"
+            << "   [ns/point, dim = " << dim << "]\n";
+  measure<compile_time::Ackley<type, dim>>();
+  measure<compile_time::Alpine<type, dim>>();
+  measure<compile_time::exponential<type, dim>>();
+  measure<compile_time::Rosenbrock<type, dim>>();
+  measure<compile_time::Schwefel<type, dim>>();
+  measure<compile_time::sphere<type, dim>>();
+}
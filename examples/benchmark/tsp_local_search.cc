@@ -0,0 +1,154 @@
+// Local search for Euclidean travelling salesman problem
+// - representation: permutation
+// - operators: permutation_local_search with O(1) delta functions for swap,
+//   2-opt and or-opt moves, with and without candidate lists (8 nearest
+//   cities)
+// - cities: drawn uniformly from unit square
+//
+// Example compilation command:
+//
+//   g++ -Wall -Wextra -pedantic -O3 -std=c++20 -pthread -DNDEBUG -I../../
+//     tsp_local_search.cc -o tsp_local_search
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <quile/quile.h>
+#include <vector>
+
+using namespace quile;
+
+namespace {
+
+template<std::size_t N>
+struct tsp
+{
+  using G = genotype<g_permutation<int, N, 0>>;
+  using C = typename G::chain_t;
+
+  std::vector<std::array<double, 2>> cities{};
+
+  tsp()
+    : cities(N)
+  {
+    for (auto& x : cities) {
+      x = { random_U(0., 1.), random_U(0., 1.) };
+    }
+  }
+
+  double dist(int a, int b) const
+  {
+    return std::hypot(cities[a][0] - cities[b][0],
+                      cities[a][1] - cities[b][1]);
+  }
+
+  static int at(const C& c, std::size_t i) { return c[(i + N) % N]; }
+
+  double length(const C& c) const
+  {
+    double res{ 0. };
+    for (std::size_t i = 0; i < N; ++i) {
+      res += dist(c[i], at(c, i + 1));
+    }
+    return res;
+  }
+
+  permutation_moves<G> moves(std::size_t k) const
+  {
+    permutation_moves<G> res{};
+    res.two_opt = [this](const C& c, std::size_t i, std::size_t j) {
+      if (i == 0 && j == N - 1) {
+        return 0.;
+      }
+      const int p = at(c, i - 1);
+      const int q = at(c, j + 1);
+      return dist(p, c[i]) + dist(c[j], q) - dist(p, c[j]) - dist(c[i], q);
+    };
+    res.or_opt =
+      [this](const C& c, std::size_t i, std::size_t l, std::size_t j) {
+        if (i == 0 && j == N - 1) {
+          return 0.;
+        }
+        const int a = at(c, i - 1);
+        const int s0 = c[i];
+        const int s1 = c[i + l - 1];
+        const int b = at(c, i + l);
+        const int x = c[j];
+        const int y = at(c, j + 1);
+        return dist(a, s0) + dist(s1, b) + dist(x, y) - dist(a, b) -
+               dist(x, s0) - dist(s1, y);
+      };
+    res.swap = [this](const C& c, std::size_t i, std::size_t j) {
+      const auto incident = [&](int ci, int cj) {
+        const auto d = [&](std::size_t k) {
+          return k == i ? ci : (k == j ? cj : at(c, k));
+        };
+        double s = dist(d((i + N - 1) % N), ci) + dist(ci, d((i + 1) % N)) +
+                   dist(d((j + N - 1) % N), cj) + dist(cj, d((j + 1) % N));
+        if (j == i + 1 || (i == 0 && j == N - 1)) {
+          s -= dist(ci, cj);
+        }
+        return s;
+      };
+      return incident(c[i], c[j]) - incident(c[j], c[i]);
+    };
+    if (k > 0) {
+      res.candidates.resize(N);
+      std::vector<int> v(N);
+      for (int a = 0; a < static_cast<int>(N); ++a) {
+        for (int b = 0; b < static_cast<int>(N); ++b) {
+          v[b] = b;
+        }
+        std::swap(v[a], v.back());
+        std::partial_sort(std::begin(v),
+                          std::begin(v) + k,
+                          std::end(v) - 1,
+                          [&](int x, int y) { return dist(a, x) < dist(a, y); });
+        res.candidates[a].assign(std::begin(v), std::begin(v) + k);
+      }
+    }
+    return res;
+  }
+};
+
+template<std::size_t N>
+void
+measure(bool full_neighborhood)
+{
+  const auto t = std::make_unique<tsp<N>>();
+  using G = typename tsp<N>::G;
+  const G g = G::random();
+  std::cout << std::setw(8) << N << std::fixed << std::setprecision(3)
+            << std::setw(12) << t->length(g.data());
+  for (std::size_t k : { std::size_t{ 8 }, std::size_t{ 0 } }) {
+    if (k == 0 && !full_neighborhood) {
+      std::cout << std::setw(12) << "--" << std::setw(12) << "--";
+      continue;
+    }
+    const auto m = permutation_local_search<G>(t->moves(k));
+    const auto t0 = std::chrono::steady_clock::now();
+    const G h = m(g).at(0);
+    const auto t1 = std::chrono::steady_clock::now();
+    std::cout << std::setw(12) << t->length(h.data()) << std::setw(12)
+              << std::chrono::duration<double, std::milli>(t1 - t0).count();
+  }
+  std::cout << '\n';
+}
+
+} // anonymous namespace
+
+int
+main()
+{
+  std::cout << "# Tour length and local search time [ms]\n"
+            << "#      N      random   len(cand)    ms(cand)"
+            << "   len(full)    ms(full)\n";
+  measure<100>(true);
+  measure<1000>(true);
+  measure<10000>(false);
+}
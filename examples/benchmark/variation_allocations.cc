@@ -0,0 +1,132 @@
+// Heap allocations and time of variation of one generation
+// - representation: floating-point (Gaussian mutation, uniform crossover) and
+//   permutation (swap mutation, cut-and-crossfill)
+// - variants: unfused variation (recombination returning population, mutation
+//   of each child returning population), fused variation with ordinary
+//   operators, fused variation with in-place operators (type-erased and
+//   static)
+//
+// Example compilation command:
+//
+//   g++ -Wall -Wextra -pedantic -O3 -std=c++20 -pthread -DNDEBUG -I../../
+//     variation_allocations.cc -o variation_allocations
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <new>
+#include <quile/quile.h>
+#include <string>
+
+namespace {
+
+std::atomic<std::size_t> allocations{ 0 };
+
+} // namespace
+
+void*
+operator new(std::size_t sz)
+{
+  ++allocations;
+  if (void* p = std::malloc(sz ? sz : 1)) {
+    return p;
+  }
+  throw std::bad_alloc{};
+}
+
+void
+operator delete(void* p) noexcept
+{
+  std::free(p);
+}
+
+void
+operator delete(void* p, std::size_t) noexcept
+{
+  std::free(p);
+}
+
+using namespace quile;
+
+namespace {
+
+const std::size_t dim = 100;
+const std::size_t generation_sz = 1000;
+const std::size_t repetitions = 100;
+const auto d = uniform_domain<double, dim>(-10., +10.);
+using F = genotype<g_floating_point<double, dim, &d>>;
+using P = genotype<g_permutation<int, dim, 0>>;
+
+// Variation as performed before fusion: every operator call returns
+// population.
+template<typename G>
+population<G>
+unfused(const mutation_fn<G>& m,
+        const recombination_fn<G>& r,
+        const population<G>& p)
+{
+  population<G> res{};
+  for (std::size_t i = 0; i < p.size(); i += 2) {
+    for (const auto& g : r(p[i], p[i + 1])) {
+      res.push_back(m(g).at(0));
+    }
+  }
+  return res;
+}
+
+template<typename G, typename V>
+void
+measure(const std::string& name, const V& v)
+{
+  population<G> p{};
+  for (std::size_t i = 0; i < generation_sz; ++i) {
+    p.push_back(G::random());
+  }
+  std::size_t sz = 0;
+  const std::size_t a0 = allocations;
+  const auto t0 = std::chrono::steady_clock::now();
+  for (std::size_t i = 0; i < repetitions; ++i) {
+    sz += v(p).size();
+  }
+  const auto t1 = std::chrono::steady_clock::now();
+  const std::size_t a1 = allocations;
+  std::cout << std::setw(36) << std::left << name << std::right
+            << std::setw(12) << (a1 - a0) / repetitions << std::setw(12)
+            << std::fixed << std::setprecision(1)
+            << std::chrono::duration<double, std::nano>(t1 - t0).count() / sz
+            << '\n';
+}
+
+template<typename G, typename M, typename R, typename IM, typename IR>
+void
+measure_all(const std::string& name, M m, R r, IM im, IR ir)
+{
+  measure<G>(name + ", unfused",
+             [=](const population<G>& p) { return unfused<G>(m, r, p); });
+  measure<G>(name + ", fused", variation<G>{ m, r });
+  measure<G>(name + ", in-place", variation<G>{ im, ir });
+  measure<G>(name + ", in-place static", static_variation<G>(im, ir));
+}
+
+} // namespace
+
+int
+main()
+{
+  std::cout << std::setw(36) << std::left << "# variation" << std::right
+            << std::setw(12) << "allocations" << std::setw(12) << "ns/child"
+            << '\n';
+  measure_all<F>("floating-point",
+                 Gaussian_mutation<F>(.1, 1. / dim),
+                 uniform_xover<F>,
+                 in_place_Gaussian_mutation<F>(.1, 1. / dim),
+                 in_place_uniform_xover<F>);
+  measure_all<P>("permutation",
+                 swap_mutation<P>,
+                 cut_n_crossfill<P>,
+                 in_place_swap_mutation<P>,
+                 in_place_cut_n_crossfill<P>);
+}
@@ -0,0 +1,135 @@
+#ifndef COMMON_CELL_LIST_H
+#define COMMON_CELL_LIST_H
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+
+// Cell list (spatial hashing of cubic cells with edge not shorter than cutoff)
+// of points in 3D, optionally periodic along z axis. Points closer than cutoff
+// are in the same or in adjacent cells, so all such pairs are found in O(n)
+// time for bounded density of points.
+class cell_list
+{
+public:
+  using point = std::array<double, 3>;
+
+  // Period equal to 0 means that z axis is not periodic. Otherwise distance
+  // of points is the minimum over their images translated along z axis by
+  // multiples of period, and period must not be shorter than cutoff.
+  cell_list(std::vector<point> ps, double cutoff, double period = 0.)
+    : ps_{ std::move(ps) }
+    , cutoff_{ cutoff }
+    , period_{ period }
+    , n_z_{ period > 0. ? std::max<std::int64_t>(
+                            1, static_cast<std::int64_t>(period / cutoff))
+                        : 0 }
+    , next_(ps_.size())
+    , cells_(ps_.size())
+  {
+    assert(cutoff > 0. && (period == 0. || period >= cutoff));
+    std::size_t sz{ 1 };
+    while (sz < 2 * ps_.size()) {
+      sz *= 2;
+    }
+    head_.assign(sz, none);
+    for (std::size_t i = 0; i < ps_.size(); ++i) {
+      if (period_ > 0.) {
+        ps_[i][2] -= period_ * std::floor(ps_[i][2] / period_);
+      }
+      cells_[i] = cell_of(ps_[i]);
+      auto& h = head_[hash(cells_[i])];
+      next_[i] = h;
+      h = i;
+    }
+  }
+
+  std::size_t size() const { return ps_.size(); }
+
+  // Calls f(i, j, d) for each pair of points i < j with distance d not
+  // greater than cutoff, as long as f returns true. Returns false if f
+  // returned false.
+  template<typename F>
+  bool for_each_pair(F f) const
+  {
+    for (std::size_t i = 0; i < ps_.size(); ++i) {
+      const auto& c = cells_[i];
+      std::array<std::int64_t, 3> zs{ c[2] - 1, c[2], c[2] + 1 };
+      std::size_t n_zs{ 3 };
+      if (n_z_) {
+        for (auto& z : zs) {
+          z = (z + n_z_) % n_z_;
+        }
+        std::sort(std::begin(zs), std::end(zs));
+        n_zs = std::unique(std::begin(zs), std::end(zs)) - std::begin(zs);
+      }
+      for (std::int64_t x = c[0] - 1; x <= c[0] + 1; ++x) {
+        for (std::int64_t y = c[1] - 1; y <= c[1] + 1; ++y) {
+          for (std::size_t k = 0; k < n_zs; ++k) {
+            const cell d{ x, y, zs[k] };
+            for (auto j = head_[hash(d)]; j != none; j = next_[j]) {
+              if (j > i && cells_[j] == d) {
+                if (const double r = distance(ps_[i], ps_[j]);
+                    r <= cutoff_ && !f(i, j, r)) {
+                  return false;
+                }
+              }
+            }
+          }
+        }
+      }
+    }
+    return true;
+  }
+
+private:
+  using cell = std::array<std::int64_t, 3>;
+  static constexpr std::size_t none{ std::numeric_limits<std::size_t>::max() };
+
+  cell cell_of(const point& p) const
+  {
+    const auto f = [this](double v) {
+      return static_cast<std::int64_t>(std::floor(v / cutoff_));
+    };
+    if (n_z_) {
+      const auto z = static_cast<std::int64_t>(p[2] * n_z_ / period_);
+      return cell{ f(p[0]), f(p[1]), std::min(z, n_z_ - 1) };
+    }
+    return cell{ f(p[0]), f(p[1]), f(p[2]) };
+  }
+
+  std::size_t hash(const cell& c) const
+  {
+    const auto h = static_cast<std::uint64_t>(c[0]) * 73856093u ^
+                   static_cast<std::uint64_t>(c[1]) * 19349663u ^
+                   static_cast<std::uint64_t>(c[2]) * 83492791u;
+    return h & (head_.size() - 1);
+  }
+
+  double distance(const point& p, const point& q) const
+  {
+    const double dx{ q[0] - p[0] };
+    const double dy{ q[1] - p[1] };
+    double dz{ q[2] - p[2] };
+    if (period_ > 0.) {
+      dz -= period_ * std::round(dz / period_);
+    }
+    return std::hypot(dx, dy, dz);
+  }
+
+  std::vector<point> ps_;
+  double cutoff_;
+  double period_;
+  std::int64_t n_z_;
+  std::vector<std::size_t> head_;
+  std::vector<std::size_t> next_;
+  std::vector<cell> cells_;
+};
+
+#endif // COMMON_CELL_LIST_H
@@ -0,0 +1,62 @@
+#ifndef COMMON_CONNECTIVITY_H
+#define COMMON_CONNECTIVITY_H
+
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <utility>
+
+// Disjoint-set forest (union by size, path halving) over n <= N elements
+// stored in place, i.e. without dynamic memory allocation.
+template<std::size_t N>
+class union_find
+{
+public:
+  explicit union_find(std::size_t n)
+    : n_{ n }
+    , components_{ n }
+  {
+    assert(n <= N);
+    for (std::size_t i = 0; i < n; ++i) {
+      parent_[i] = i;
+      size_[i] = 1;
+    }
+  }
+
+  std::size_t find(std::size_t i)
+  {
+    assert(i < n_);
+    while (parent_[i] != i) {
+      i = parent_[i] = parent_[parent_[i]];
+    }
+    return i;
+  }
+
+  // Returns true if i and j were in different sets.
+  bool unite(std::size_t i, std::size_t j)
+  {
+    i = find(i);
+    j = find(j);
+    if (i == j) {
+      return false;
+    }
+    if (size_[i] < size_[j]) {
+      std::swap(i, j);
+    }
+    parent_[j] = i;
+    size_[i] += size_[j];
+    --components_;
+    return true;
+  }
+
+  std::size_t size() const { return n_; }
+  std::size_t components() const { return components_; }
+
+private:
+  std::array<std::size_t, N> parent_;
+  std::array<std::size_t, N> size_;
+  std::size_t n_;
+  std::size_t components_;
+};
+
+#endif // COMMON_CONNECTIVITY_H
@@ -2,11 +2,11 @@
 // - representation: floating-point
 // - variation type: random-reset mutation, single arithmetic recombination
 // - parents/surivor selection: stochastic universal sampling (SUS)
+// - offspring pre-screening (optional): k-nearest-neighbor surrogate model
 // - termination condition: based on maximum fitness improvement
 
 #include "../common/pwx.h"
 #include "../common/system.h"
-#include "../common/ts_unordered_map.h"
 #include "src/nanowire.h"
 #include <algorithm>
 #include <cassert>
@@ -14,6 +14,7 @@
 #include <fstream>
 #include <iomanip>
 #include <ios>
+#include <iostream>
 #include <quile/quile.h>
 #include <string>
 
@@ -23,7 +24,7 @@ using namespace evenstar;
 namespace {
 
 template<typename G>
-thread_safe_unordered_map<G, std::string> file_db{};
+concurrent_unordered_map<G, std::string> file_db{};
 
 using type = double;
 const bool flat = FLAT;
@@ -39,7 +40,7 @@ void
 input_file(const std::string& filename, const G& g)
 {
   const int k_points = 8;
-  file_db<G>.insert_or_modify(g, filename);
+  file_db<G>.insert_or_assign(g, filename);
   std::ofstream file{ filename };
   const auto [p, h] = geometry<G>(g, atom.symbol, flat);
   const auto max_x = std::ranges::max_element(p, {}, &pwx_position::x)->x;
@@ -60,7 +61,8 @@ nanowire_condition(const G& g)
 {
   const auto [ps, h] = geometry<G>(g, atom.symbol, flat);
   return atoms_not_too_close_pbc(ps, h, bond_range.min()) &&
-         all_atoms_connected_pbc(ps, h, bond_range.max());
+         all_atoms_connected_pbc<number_of_atoms<G>(flat)>(
+           ps, h, bond_range.max());
 }
 
 double
@@ -87,9 +89,18 @@ main()
   const fitness_db<G> fd{ ff, nanowire_condition<G> };
   const ranking_selection<G> rs{ fd, linear_ranking_selection(2.) };
 
-  const auto p0 = random_population<nanowire_condition<G>, G>;
+  const auto sampler = []() { return sample_chain<G>(bond_range, flat); };
+  const constrained_population<G> p0{ nanowire_condition<G>, sampler };
   const auto p1 = stochastic_universal_sampling<G>{ rs };
+#ifdef SURROGATE_SCREENING
+  // Only the more promising half of offspring (according to surrogate model
+  // trained on calculated ones) is calculated.
+  const knn_surrogate<G> s{};
+  const auto p2 = surrogate_screening<G>(
+    adapter<G>(stochastic_universal_sampling<G>{ rs }), fd, s, .5, 100);
+#else
   const auto p2 = adapter<G>(stochastic_universal_sampling<G>{ rs });
+#endif
 
   const std::size_t generation_sz{ 100 };
   const std::size_t parents_sz{ 64 };
@@ -109,4 +120,10 @@ main()
     }
     ++i;
   }
+  std::cout << "Initialization acceptance rate: " << p0.acceptance_rate()
+            << '\n';
+#ifdef SURROGATE_SCREENING
+  std::cout << "Surrogate mean absolute error: " << s.mean_absolute_error()
+            << " Ry (" << s.validated() << " predictions)\n";
+#endif
 }
@@ -1,16 +1,16 @@
 #ifndef EVENSTAR_SRC_NANOWIRE_H
 #define EVENSTAR_SRC_NANOWIRE_H
 
+#include "../../common/cell_list.h"
+#include "../../common/connectivity.h"
 #include "../../common/pwx.h"
 #include <algorithm>
-#include <boost/graph/adjacency_matrix.hpp>
-#include <boost/graph/connected_components.hpp>
 #include <cassert>
+#include <cmath>
 #include <concepts>
 #include <cstddef>
 #include <numbers>
 #include <quile/quile.h>
-#include <ranges>
 #include <string>
 #include <tuple>
 #include <vector>
@@ -86,18 +86,20 @@ requires(N_A > 0) quile::domain<T, genotype_size<N_A>(Flat)> construct_domain(
 
 namespace detail {
 
-// Mystic Rose is a complete graph with vertices placed on the points of
-// a regular polygon. This function returns edges needed to construct this
-// graph, e.g. for (0, 1, 2) it returns ((0, 1), (0, 2), (1, 2)).
-template<typename C>
-std::vector<std::tuple<typename C::value_type, typename C::value_type>>
-mystic_rose_edges(const C& c)
+// Below this number of atoms in unit cell all pairs are checked in place,
+// without dynamic memory allocation; cell list pays off for larger cells.
+inline constexpr std::size_t cell_list_min_atoms{ 16 };
+
+// Coordinates of atoms of unit cell and of its copies translated by
+// multiples of h along nanowire axis.
+inline std::vector<cell_list::point>
+coordinates(const pwx_positions& ps, double h, std::size_t copies)
 {
-  using T = typename C::value_type;
-  std::vector<std::tuple<T, T>> res{};
-  for (std::size_t i = 0; const auto& x : c) {
-    for (const auto& y : c | std::views::drop(++i)) {
-      res.push_back(std::make_tuple(x, y));
+  std::vector<cell_list::point> res{};
+  res.reserve(copies * ps.size());
+  for (std::size_t k = 0; k < copies; ++k) {
+    for (const auto& p : ps) {
+      res.push_back(cell_list::point{ p.x, p.y, p.z + k * h });
     }
   }
   return res;
@@ -105,42 +107,64 @@ mystic_rose_edges(const C& c)
 
 } // namespace detail
 
-// This function template checks if all atoms are separated from each other.
+// This function template checks if all atoms are separated from each other,
+// also from their images in neighbor unit cells.
 template<std::floating_point T>
 bool
 atoms_not_too_close_pbc(const pwx_positions& ps, T h, T min_distance)
 {
-  return std::ranges::all_of(
-           detail::mystic_rose_edges(ps),
-           [=](const auto& t) { return pwx_distance(t) >= min_distance; }) &&
-         std::ranges::all_of(detail::mystic_rose_edges(ps),
-                             [=](const auto& t) {
-                               return pwx_distance_pbc(t, 0., 0., h) >=
-                                      min_distance;
-                             }) &&
-         (h >= min_distance);
+  if (h < min_distance) {
+    return false;
+  }
+  if (ps.size() < detail::cell_list_min_atoms) {
+    for (std::size_t i = 0; i < ps.size(); ++i) {
+      for (std::size_t j = i + 1; j < ps.size(); ++j) {
+        const auto& p = ps[i];
+        const auto& q = ps[j];
+        for (const T dz : { -h, T{ 0 }, h }) {
+          if (std::hypot(q.x - p.x, q.y - p.y, q.z + dz - p.z) < min_distance) {
+            return false;
+          }
+        }
+      }
+    }
+    return true;
+  }
+  const cell_list cl{ detail::coordinates(ps, h, 1), min_distance, h };
+  return cl.for_each_pair(
+    [=](std::size_t, std::size_t, double d) { return d >= min_distance; });
 }
 
-// This function template checks if all atoms are connected, i.e. form a wire.
-template<std::floating_point T>
+// This function template checks if all atoms (at most N) are connected, i.e.
+// form a wire. Atoms of unit cell and of its image translated by h along
+// nanowire axis are vertices of checked graph.
+template<std::size_t N, std::floating_point T>
 bool
-all_atoms_connected_pbc(pwx_positions ps, T h, T max_distance)
+all_atoms_connected_pbc(const pwx_positions& ps, T h, T max_distance)
 {
   const std::size_t n{ ps.size() };
-  for (std::size_t i = 0; i < n; ++i) {
-    ps.push_back(pwx_position{ ps[i].symbol, ps[i].x, ps[i].y, ps[i].z + h });
-  }
-  assert(ps.size() == 2 * n);
-  boost::adjacency_matrix<boost::undirectedS> g{ ps.size() };
-  std::vector<std::size_t> v(ps.size()); // Do not use {...} here!
-  std::iota(v.begin(), v.end(), 0);
-  for (auto [i, j] : detail::mystic_rose_edges(v)) {
-    if (ps[i].distance(ps[j]) <= max_distance) {
-      boost::add_edge(i, j, g);
+  assert(n <= N);
+  if (n < detail::cell_list_min_atoms) {
+    union_find<2 * N> uf{ 2 * n };
+    for (std::size_t i = 0; i < 2 * n && uf.components() > 1; ++i) {
+      for (std::size_t j = i + 1; j < 2 * n; ++j) {
+        const auto& p = ps[i % n];
+        const auto& q = ps[j % n];
+        const T dz{ (j < n ? 0 : h) - (i < n ? 0 : h) };
+        if (std::hypot(q.x - p.x, q.y - p.y, q.z + dz - p.z) <= max_distance) {
+          uf.unite(i, j);
+        }
+      }
     }
+    return uf.components() == 1;
   }
-  std::vector<std::size_t> c(boost::num_vertices(g)); // And here.
-  return 1 == boost::connected_components(g, c.data());
+  const cell_list cl{ detail::coordinates(ps, h, 2), max_distance };
+  union_find<2 * N> uf{ cl.size() };
+  cl.for_each_pair([&](std::size_t i, std::size_t j, double) {
+    uf.unite(i, j);
+    return uf.components() > 1;
+  });
+  return uf.components() == 1;
 }
 
 pwx_positions
@@ -209,6 +233,78 @@ geometry(const G& g, const std::string& atom_symbol, bool flat)
               : detail::geometry_buckled<G>(g, atom_symbol);
 }
 
+// Constructive sampler placing atoms one by one, each at random distance from
+// bond range to the previous atom, and if found within limited number of
+// trials, not closer than bond.min() to any other atom placed so far and close
+// enough to nanowire axis to come back to it in remaining steps. The last
+// step, i.e. distance of the last atom to the image of the first one in the
+// neighbor unit cell, is drawn from bond range too. Chain of atoms is thus
+// connected by construction, and only distances between atoms and images of
+// other atoms are left to chance.
+template<typename G>
+requires quile::floating_point_chromosome<G> G
+sample_chain(const quile::range<typename G::gene_t>& bond, bool flat)
+{
+  using T = typename G::gene_t;
+  const auto& d = G::constraints();
+  const std::size_t n{ number_of_atoms<G>(flat) };
+  const std::size_t max_trials{ 100 };
+  const auto lateral = [](const cell_list::point& p) {
+    return std::hypot(p[0], p[1]);
+  };
+  typename G::chain_t c{};
+  std::vector<cell_list::point> ps{ cell_list::point{ 0., 0., 0. } };
+  std::size_t k{ 1 };
+  for (std::size_t i = 1; i < n; ++i) {
+    const auto prev = ps.back();
+    cell_list::point p{};
+    for (std::size_t t = 0; t < max_trials; ++t) {
+      const T r{ quile::random_U(bond.min(), bond.max()) };
+      const T dz{ quile::random_U(T{ 0 }, r) };
+      const T s{ std::sqrt(r * r - dz * dz) };
+      // Flat nanowire grows in either direction of y axis, atom 1 of
+      // buckled one lies on x axis.
+      T theta{ 0 };
+      if (flat) {
+        theta = quile::random_U(0., 1.) < .5 ? 0 : std::numbers::pi_v<T>;
+      } else if (i > 1) {
+        theta = quile::random_U(T{ 0 }, 2 * std::numbers::pi_v<T>);
+      }
+      p = cell_list::point{ flat ? 0. : prev[0] + s * std::cos(theta),
+                            prev[1] + s * std::sin(theta),
+                            prev[2] + dz };
+      if (lateral(p) <= (n - i) * bond.max() &&
+          std::ranges::all_of(ps, [&](const auto& q) {
+            return std::hypot(p[0] - q[0], p[1] - q[1], p[2] - q[2]) >=
+                   bond.min();
+          })) {
+        break;
+      }
+    }
+    if (flat) {
+      c[k] = d[k].clamp(p[1]);
+    } else {
+      const auto [rho, phi] = quile::cart2polar(p[0], p[1]);
+      c[k] = d[k].clamp(rho);
+      if (i > 1) {
+        ++k;
+        c[k] = d[k].clamp(phi);
+      }
+    }
+    ++k;
+    c[k] = d[k].clamp(p[2] - prev[2]);
+    ++k;
+    ps.push_back(p);
+  }
+  assert(k == G::size());
+  const T l{ lateral(ps.back()) };
+  const T r{ l <= bond.max()
+               ? quile::random_U(std::max(l, bond.min()), bond.max())
+               : bond.max() };
+  c[0] = d[0].clamp(std::sqrt(std::max(r * r - l * l, T{ 0 })));
+  return G{ c };
+}
+
 } // namespace evenstar
 
 #endif // EVENSTAR_SRC_NANOWIRE_H
@@ -11,6 +11,7 @@
 #include <fstream>
 #include <iomanip>
 #include <ios>
+#include <iostream>
 #include <quile/quile.h>
 
 using namespace quile;
@@ -44,10 +45,15 @@ main()
     return energy_from_model<G, n_phi, n_z>(g, decomposition_values);
   };
 
-  const fitness_db<G> fd{ ff, nanotube_condition<G, n_phi, n_z>, 1 };
+  const batch_fitness_function<G> bf = [](const population<G>& p) {
+    return energies_from_model<G, n_phi, n_z>(p, decomposition_values);
+  };
+
+  const fitness_db<G> fd{ ff, bf, nanotube_condition<G, n_phi, n_z>, 1 };
   const ranking_selection<G> rs{ fd, linear_ranking_selection(2.) };
 
-  const auto p0 = random_population<nanotube_condition<G, n_phi, n_z>, G>;
+  const constrained_population<G> p0{ nanotube_condition<G, n_phi, n_z>,
+                                     grow_connected_cluster<G, n_phi, n_z> };
   const auto p1 = stochastic_universal_sampling<G>{ rs };
   const auto p2 = adapter<G>(stochastic_universal_sampling<G>{ rs });
 
@@ -70,4 +76,6 @@ main()
     }
     ++i;
   }
+  std::cout << "Initialization acceptance rate: " << p0.acceptance_rate()
+            << '\n';
 }
@@ -1,10 +1,13 @@
 #ifndef MITHRIL_SRC_NANOTUBE_H
 #define MITHRIL_SRC_NANOTUBE_H
 
+#include "../../common/connectivity.h"
 #include <algorithm>
-#include <boost/graph/adjacency_matrix.hpp>
-#include <boost/graph/connected_components.hpp>
+#include <array>
+#include <bit>
+#include <compare>
 #include <cstddef>
+#include <cstdint>
 #include <iterator>
 #include <quile/quile.h>
 #include <ranges>
@@ -122,47 +125,240 @@ number_of_neighbor_atoms_ord(const G& g, std::size_t i)
     hl.neighbors(i), true, [&](std::size_t j) { return g.value(j); });
 }
 
-// Motif decomposition (n_0, n_1, ..., n_6).
-template<quile::binary_chromosome G, std::size_t n_phi, std::size_t n_z>
-std::vector<std::size_t>
-decomposition(const G& g)
+namespace detail {
+
+// Bitboard of hexagonal lattice: site i is bit i % 64 of word i / 64.
+template<std::size_t n_phi, std::size_t n_z>
+using hex_bitboard = quile::packed_chain<2 * n_phi * n_z>;
+
+// Returns len <= 64 consecutive bits of p starting at site first
+// (first + len <= N).
+template<std::size_t N>
+std::uint64_t
+bits(const quile::packed_chain<N>& p, std::size_t first, std::size_t len)
 {
-  std::vector<std::size_t> res{ 0, 0, 0, 0, 0, 0, 0 };
-  for (std::size_t i = 0; i < G::size(); ++i) {
-    if (g.value(i)) {
-      ++res[number_of_neighbor_atoms_pbc<G, n_phi, n_z>(g, i)];
+  const std::size_t w{ first / 64 };
+  const std::size_t o{ first % 64 };
+  std::uint64_t res{ p[w] >> o };
+  if (o && o + len > 64) {
+    res |= p[w + 1] << (64 - o);
+  }
+  return len < 64 ? res & ((std::uint64_t{ 1 } << len) - 1) : res;
+}
+
+// Cyclic shift: bit i of result is bit (i + k) % N of p.
+template<std::size_t N>
+quile::packed_chain<N>
+cyclic_shift(const quile::packed_chain<N>& p, std::size_t k)
+{
+  quile::packed_chain<N> res{};
+  for (std::size_t w = 0; w < res.size(); ++w) {
+    const std::size_t n{ std::min<std::size_t>(64, N - 64 * w) };
+    for (std::size_t done = 0, i = (64 * w + k) % N; done < n; i = 0) {
+      const std::size_t len{ std::min(n - done, N - i) };
+      res[w] |= bits<N>(p, i, len) << done;
+      done += len;
     }
   }
   return res;
 }
 
-// Energy from decomposition model.
-template<quile::binary_chromosome G, std::size_t n_phi, std::size_t n_z>
+// Word-wise (p0 & m) | (p1 & ~m).
+template<std::size_t W>
+std::array<std::uint64_t, W>
+blend(const std::array<std::uint64_t, W>& m,
+      const std::array<std::uint64_t, W>& p0,
+      const std::array<std::uint64_t, W>& p1)
+{
+  std::array<std::uint64_t, W> res{};
+  for (std::size_t i = 0; i < W; ++i) {
+    res[i] = (p0[i] & m[i]) | (p1[i] & ~m[i]);
+  }
+  return res;
+}
+
+// Masks of sites in even rows, first column and last column of lattice.
+template<std::size_t n_phi, std::size_t n_z>
+struct hex_masks
+{
+  hex_bitboard<n_phi, n_z> even_rows{};
+  hex_bitboard<n_phi, n_z> first_column{};
+  hex_bitboard<n_phi, n_z> last_column{};
+};
+
+template<std::size_t n_phi, std::size_t n_z>
+const hex_masks<n_phi, n_z>&
+masks()
+{
+  static const hex_masks<n_phi, n_z> res = []() {
+    hex_masks<n_phi, n_z> m{};
+    for (std::size_t i = 0; i < 2 * n_phi * n_z; ++i) {
+      const std::uint64_t b{ std::uint64_t{ 1 } << (i % 64) };
+      m.even_rows[i / 64] |= (i / n_z) % 2 == 0 ? b : 0;
+      m.first_column[i / 64] |= i % n_z == 0 ? b : 0;
+      m.last_column[i / 64] |= i % n_z == n_z - 1 ? b : 0;
+    }
+    return m;
+  }();
+  return res;
+}
+
+// Bit i of result is bit hex_lattice_pbc::right(i) of p.
+template<std::size_t n_phi, std::size_t n_z>
+hex_bitboard<n_phi, n_z>
+right_of(const hex_bitboard<n_phi, n_z>& p)
+{
+  const std::size_t c{ 2 * n_phi * n_z };
+  return blend(masks<n_phi, n_z>().last_column,
+               cyclic_shift<c>(p, c - n_z + 1),
+               cyclic_shift<c>(p, 1));
+}
+
+// Bit i of result is bit hex_lattice_pbc::left(i) of p.
+template<std::size_t n_phi, std::size_t n_z>
+hex_bitboard<n_phi, n_z>
+left_of(const hex_bitboard<n_phi, n_z>& p)
+{
+  const std::size_t c{ 2 * n_phi * n_z };
+  return blend(masks<n_phi, n_z>().first_column,
+               cyclic_shift<c>(p, n_z - 1),
+               cyclic_shift<c>(p, c - 1));
+}
+
+// Number of neighbor atoms of each site (periodic boundary condition) in
+// bit-sliced form: bit i of res[k] is bit k of the number for site i.
+template<std::size_t n_phi, std::size_t n_z>
+std::array<hex_bitboard<n_phi, n_z>, 3>
+neighbor_counts_pbc(const hex_bitboard<n_phi, n_z>& p)
+{
+  const std::size_t c{ 2 * n_phi * n_z };
+  const auto& e = masks<n_phi, n_z>().even_rows;
+  const auto up = cyclic_shift<c>(p, n_z);
+  const auto down = cyclic_shift<c>(p, c - n_z);
+  const std::array<hex_bitboard<n_phi, n_z>, 6> n{
+    blend(e, left_of<n_phi, n_z>(up), up),
+    blend(e, up, right_of<n_phi, n_z>(up)),
+    left_of<n_phi, n_z>(p),
+    right_of<n_phi, n_z>(p),
+    blend(e, left_of<n_phi, n_z>(down), down),
+    blend(e, down, right_of<n_phi, n_z>(down))
+  };
+  std::array<hex_bitboard<n_phi, n_z>, 3> res{};
+  for (std::size_t w = 0; w < p.size(); ++w) {
+    // Two full adders sum neighbors in groups of three, third one sums
+    // carries of them and of the sum of partial sums.
+    const auto carry = [](std::uint64_t x, std::uint64_t y, std::uint64_t z) {
+      return (x & y) | (z & (x ^ y));
+    };
+    const std::uint64_t s0{ n[0][w] ^ n[1][w] ^ n[2][w] };
+    const std::uint64_t c0{ carry(n[0][w], n[1][w], n[2][w]) };
+    const std::uint64_t s1{ n[3][w] ^ n[4][w] ^ n[5][w] };
+    const std::uint64_t c1{ carry(n[3][w], n[4][w], n[5][w]) };
+    const std::uint64_t c2{ s0 & s1 };
+    res[0][w] = s0 ^ s1;
+    res[1][w] = c0 ^ c1 ^ c2;
+    res[2][w] = carry(c0, c1, c2);
+  }
+  return res;
+}
+
+// Motif decomposition (n_0, n_1, ..., n_6) of packed chain.
+template<std::size_t n_phi, std::size_t n_z>
+std::array<std::size_t, 7>
+decomposition(const hex_bitboard<n_phi, n_z>& p)
+{
+  const auto n = neighbor_counts_pbc<n_phi, n_z>(p);
+  std::array<std::size_t, 7> res{};
+  for (std::size_t w = 0; w < p.size(); ++w) {
+    for (std::size_t k = 0; k < res.size(); ++k) {
+      std::uint64_t m{ p[w] };
+      for (std::size_t b = 0; b < n.size(); ++b) {
+        m &= (k >> b) & 1 ? n[b][w] : ~n[b][w];
+      }
+      res[k] += std::popcount(m);
+    }
+  }
+  return res;
+}
+
+// Energy from decomposition model of packed chain.
+template<std::size_t n_phi, std::size_t n_z>
 double
-energy_from_model(const G& g, const double* decomposition_values)
+energy_from_model(const hex_bitboard<n_phi, n_z>& p,
+                  const double* decomposition_values)
 {
   double res{ 0. };
-  for (std::size_t i = 0; auto n : decomposition<G, n_phi, n_z>(g)) {
+  std::size_t atoms{ 0 };
+  for (std::size_t i = 0; auto n : decomposition<n_phi, n_z>(p)) {
     res += n * decomposition_values[i++];
+    atoms += n;
   }
-  return res / number_of_atoms(g);
+  return res / atoms;
+}
+
+} // namespace detail
+
+// Motif decomposition (n_0, n_1, ..., n_6). Neighbor counts of all sites are
+// computed on bitboard with shifted word masks, buckets with popcounts.
+template<quile::binary_chromosome G, std::size_t n_phi, std::size_t n_z>
+std::vector<std::size_t>
+decomposition(const G& g)
+{
+  static_assert(G::size() == 2 * n_phi * n_z);
+  const auto res = detail::decomposition<n_phi, n_z>(quile::pack(g.data()));
+  return std::vector<std::size_t>(std::begin(res), std::end(res));
 }
 
-// Predicate testing whether atoms are connected within unit cell.
+// Energy from decomposition model.
+template<quile::binary_chromosome G, std::size_t n_phi, std::size_t n_z>
+double
+energy_from_model(const G& g, const double* decomposition_values)
+{
+  static_assert(G::size() == 2 * n_phi * n_z);
+  return detail::energy_from_model<n_phi, n_z>(quile::pack(g.data()),
+                                               decomposition_values);
+}
+
+// Energies from decomposition model of all genotypes of population.
+template<quile::binary_chromosome G, std::size_t n_phi, std::size_t n_z>
+quile::fitnesses
+energies_from_model(const quile::population<G>& p,
+                    const double* decomposition_values)
+{
+  static_assert(G::size() == 2 * n_phi * n_z);
+  quile::fitnesses res(p.size());
+  std::ranges::transform(p, std::begin(res), [&](const G& g) {
+    return detail::energy_from_model<n_phi, n_z>(quile::pack(g.data()),
+                                                 decomposition_values);
+  });
+  return res;
+}
+
+// Predicate testing whether atoms are connected within unit cell (union-find
+// over lattice sites, without periodic boundary condition).
 template<quile::binary_chromosome G, std::size_t n_phi, std::size_t n_z>
 bool
 atoms_connected_in_unit_cell(const G& g)
 {
   static const hex_lattice_ord hl{ n_phi, n_z };
-  boost::adjacency_matrix<boost::undirectedS> am{ G::size() };
-  for (auto i : atoms(g)) {
-    for (auto j : neighbor_atoms_ord<G, n_phi, n_z>(g, i)) {
-      boost::add_edge(i, j, am);
+  union_find<G::size()> uf{ G::size() };
+  std::size_t atoms{ 0 };
+  for (std::size_t i = 0; i < G::size(); ++i) {
+    if (g.value(i)) {
+      ++atoms;
+      for (const auto f : { &hex_lattice_ord::up_left,
+                            &hex_lattice_ord::up_right,
+                            &hex_lattice_ord::left,
+                            &hex_lattice_ord::right,
+                            &hex_lattice_ord::down_left,
+                            &hex_lattice_ord::down_right }) {
+        if (const auto j = (hl.*f)(i); g.value(j)) {
+          uf.unite(i, j);
+        }
+      }
     }
   }
-  std::vector<std::size_t> c(boost::num_vertices(am));
-  return number_of_atoms(g) + boost::connected_components(am, c.data()) ==
-         1 + G::size();
+  return atoms + uf.components() == 1 + G::size();
 }
 
 // Predicate testing whether at least one atom at unit cell boundary along
@@ -203,18 +399,64 @@ adjacency_at_unit_cell_boundary_at_circumference(const G& g)
   return false;
 }
 
-// operator>> reads genotype from the stream.
-// TODO: Move this to the Quilë library.
-template<quile::chromosome G>
-std::istream&
-operator>>(std::istream& is, G& g)
+// Constructive sampler growing connected cluster of atoms (without periodic
+// boundary condition) up to random number of atoms. Growth starts from
+// skeleton consisting of random even row, whose atoms are adjacent at unit
+// cell boundary along nanotube, and random walk through all rows from random
+// atom of the first row, closed by segment of the first row ending at atom
+// adjacent to the last atom of the walk at unit cell boundary at
+// circumference, so all nanotube conditions hold by construction.
+template<quile::binary_chromosome G, std::size_t n_phi, std::size_t n_z>
+G
+grow_connected_cluster()
 {
+  static const hex_lattice_ord hl{ n_phi, n_z };
+  typename G::chain_t c{};
+  const std::size_t row{ 2 * quile::random_U<std::size_t>(0, n_phi - 1) };
+  for (std::size_t i = 0; i < n_z; ++i) {
+    c[row * n_z + i] = true;
+  }
+  const auto first = quile::random_U<std::size_t>(0, n_z - 1);
+  std::size_t i{ first };
+  c[i] = true;
+  for (std::size_t k = 1; k < 2 * n_phi; ++k) {
+    // At least one of upper neighbors exists below the last row.
+    const std::size_t l{ hl.up_left(i) };
+    const std::size_t r{ hl.up_right(i) };
+    i = l == i || (r != i && quile::random_U<std::size_t>(0, 1)) ? r : l;
+    c[i] = true;
+  }
+  // Upper left neighbor of atom of the last row (periodic boundary condition)
+  // is in the same column of the first row.
+  const std::size_t last{ i % n_z };
+  for (std::size_t j = std::min(first, last); j <= std::max(first, last); ++j) {
+    c[j] = true;
+  }
+  std::vector<std::size_t> frontier{};
   for (std::size_t i = 0; i < G::size(); ++i) {
-    typename G::gene_t v{};
-    is >> v;
-    g.value(i, v);
+    if (c[i]) {
+      std::ranges::copy_if(hl.neighbors(i),
+                           std::back_inserter(frontier),
+                           [&](std::size_t j) { return !c[j]; });
+    }
+  }
+  const auto skeleton_sz =
+    static_cast<std::size_t>(std::ranges::count(c, true));
+  const auto atoms_sz = quile::random_U<std::size_t>(skeleton_sz, G::size());
+  for (std::size_t atoms = skeleton_sz; atoms < atoms_sz;) {
+    const auto k = quile::random_U<std::size_t>(0, frontier.size() - 1);
+    const std::size_t i{ frontier[k] };
+    frontier[k] = frontier.back();
+    frontier.pop_back();
+    if (!c[i]) {
+      c[i] = true;
+      ++atoms;
+      std::ranges::copy_if(hl.neighbors(i),
+                           std::back_inserter(frontier),
+                           [&](std::size_t j) { return !c[j]; });
+    }
   }
-  return is;
+  return G{ c };
 }
 
 // Rotates nanotube representation by positive value delta.
@@ -254,24 +496,121 @@ compare_as_unsigned_numbers(const G& g0, const G& g1)
   return c0 <=> c1;
 }
 
-// Finds minimum of the nanotube abstract class representation.
-template<quile::binary_chromosome G, std::size_t n_phi, std::size_t n_z>
-G
-find_min_element_of_abstract_class(const G& g)
+namespace detail {
+
+// Three-way comparison of packed chains with unsigned numbers interpretation.
+template<std::size_t W>
+std::strong_ordering
+compare_as_unsigned_numbers(const std::array<std::uint64_t, W>& p0,
+                            const std::array<std::uint64_t, W>& p1)
+{
+  for (std::size_t w = W; w-- > 0;) {
+    if (p0[w] != p1[w]) {
+      return p0[w] <=> p1[w];
+    }
+  }
+  return std::strong_ordering::equal;
+}
+
+// Word-level rotate: bit (i + 2 * delta * n_z) % (2 * n_phi * n_z) of result
+// is bit i of p.
+template<std::size_t n_phi, std::size_t n_z>
+hex_bitboard<n_phi, n_z>
+rotate(const hex_bitboard<n_phi, n_z>& p, std::size_t delta)
 {
-  G min{ g };
-  for (std::size_t d_n_phi = 0; d_n_phi < n_phi; ++d_n_phi) {
-    for (std::size_t d_n_z = 0; d_n_z < n_z; ++d_n_z) {
-      G h{ rotate<G, n_phi, n_z>(translate<G, n_phi, n_z>(g, d_n_z), d_n_phi) };
-      if (compare_as_unsigned_numbers(h, min) < 0) {
-        min = h;
+  const std::size_t c{ 2 * n_phi * n_z };
+  return cyclic_shift<c>(p, c - 2 * (delta % n_phi) * n_z);
+}
+
+// Word-level translate: bit (i + delta) % n_z + (i / n_z) * n_z of result is
+// bit i of p.
+template<std::size_t n_phi, std::size_t n_z>
+hex_bitboard<n_phi, n_z>
+translate(const hex_bitboard<n_phi, n_z>& p, std::size_t delta)
+{
+  // Masks of columns not lower than delta.
+  static const auto columns = []() {
+    std::array<hex_bitboard<n_phi, n_z>, n_z> res{};
+    for (std::size_t i = 0; i < 2 * n_phi * n_z; ++i) {
+      for (std::size_t d = 0; d <= i % n_z; ++d) {
+        res[d][i / 64] |= std::uint64_t{ 1 } << (i % 64);
       }
     }
+    return res;
+  }();
+  const std::size_t c{ 2 * n_phi * n_z };
+  delta %= n_z;
+  return delta ? blend(columns[delta],
+                       cyclic_shift<c>(p, c - delta),
+                       cyclic_shift<c>(p, n_z - delta))
+               : p;
+}
+
+// Three-way comparison of pairs of rows k and l (2 * n_z bits each) with
+// unsigned numbers interpretation.
+template<std::size_t n_phi, std::size_t n_z>
+std::strong_ordering
+compare_row_pairs(const hex_bitboard<n_phi, n_z>& p,
+                  std::size_t k,
+                  std::size_t l)
+{
+  const std::size_t c{ 2 * n_phi * n_z };
+  for (std::size_t last = 2 * n_z; last > 0;) {
+    const std::size_t len{ std::min<std::size_t>(64, last) };
+    last -= len;
+    const auto b0 = bits<c>(p, 2 * k * n_z + last, len);
+    const auto b1 = bits<c>(p, 2 * l * n_z + last, len);
+    if (b0 != b1) {
+      return b0 <=> b1;
+    }
   }
-  return min;
+  return std::strong_ordering::equal;
 }
 
-namespace detail {
+// Finds delta for which rotate(p, delta) is minimal. Rotations are compared
+// as sequences of pairs of rows, starting with the most significant one, by
+// minimum expression (two-pointer) algorithm in O(n_phi) comparisons.
+template<std::size_t n_phi, std::size_t n_z>
+std::size_t
+least_rotation(const hex_bitboard<n_phi, n_z>& p)
+{
+  // Pair of rows at position m of rotation delta, counted from the most
+  // significant one.
+  const auto row_pair = [](std::size_t delta, std::size_t m) {
+    return n_phi - 1 - (delta + m) % n_phi;
+  };
+  std::size_t i{ 0 };
+  std::size_t j{ 1 };
+  std::size_t k{ 0 };
+  while (i < n_phi && j < n_phi && k < n_phi) {
+    const auto cmp =
+      compare_row_pairs<n_phi, n_z>(p, row_pair(i, k), row_pair(j, k));
+    if (cmp == 0) {
+      ++k;
+      continue;
+    }
+    (cmp > 0 ? i : j) += k + 1;
+    j += i == j;
+    k = 0;
+  }
+  return std::min(i, j);
+}
+
+// Minimum of the nanotube abstract class representation of packed chain.
+template<std::size_t n_phi, std::size_t n_z>
+hex_bitboard<n_phi, n_z>
+canonical_form(const hex_bitboard<n_phi, n_z>& p)
+{
+  hex_bitboard<n_phi, n_z> res{ p };
+  for (std::size_t d_n_z = 0; d_n_z < n_z; ++d_n_z) {
+    const auto t = translate<n_phi, n_z>(p, d_n_z);
+    const auto h = rotate<n_phi, n_z>(t, least_rotation<n_phi, n_z>(t));
+    if (compare_as_unsigned_numbers(h, res) < 0) {
+      res = h;
+    }
+  }
+  return res;
+}
 
 // Computes divisors of a number.
 std::vector<std::size_t>
@@ -279,15 +618,30 @@ divisors(std::size_t n);
 
 } // namespace detail
 
+// Finds minimum of the nanotube abstract class representation, i.e. canonical
+// form of the symmetry class generated by rotate and translate. For each of
+// n_z translations the minimal rotation is found with word-level operations on
+// packed chain, so genotypes with equal canonical form have equal energy and
+// the canonical form may serve as fitness cache key.
+template<quile::binary_chromosome G, std::size_t n_phi, std::size_t n_z>
+G
+find_min_element_of_abstract_class(const G& g)
+{
+  static_assert(G::size() == 2 * n_phi * n_z);
+  return G{ quile::unpack<G::size()>(
+    detail::canonical_form<n_phi, n_z>(quile::pack(g.data()))) };
+}
+
 // Computes d_n_phi.
 template<quile::binary_chromosome G, std::size_t n_phi, std::size_t n_z>
 std::size_t
 d_n_phi(const G& g)
 {
   static const auto divs{ detail::divisors(n_phi) };
+  const auto p = quile::pack(g.data());
   std::size_t res{ 1 };
   for (auto d : divs) {
-    if (g == rotate<G, n_phi, n_z>(g, n_phi / d) && d > res) {
+    if (p == detail::rotate<n_phi, n_z>(p, n_phi / d) && d > res) {
       res = d;
     }
   }
@@ -300,9 +654,10 @@ std::size_t
 d_n_z(const G& g)
 {
   static const auto divs{ detail::divisors(n_z) };
+  const auto p = quile::pack(g.data());
   std::size_t res{ 1 };
   for (auto d : divs) {
-    if (g == translate<G, n_phi, n_z>(g, n_z / d) && d > res) {
+    if (p == detail::translate<n_phi, n_z>(p, n_z / d) && d > res) {
       res = d;
     }
   }
@@ -27,12 +27,16 @@
 
 #include <algorithm>
 #include <array>
+#include <atomic>
+#include <bit>
 #include <cassert>
+#include <chrono>
 #include <climits>
 #include <cmath>
 #include <concepts>
 #include <condition_variable>
 #include <cstddef>
+#include <cstdint>
 #include <deque>
 #include <functional>
 #include <future>
@@ -45,16 +49,32 @@
 #include <mutex>
 #include <numbers>
 #include <numeric>
+#include <optional>
+#include <queue>
 #include <random>
 #include <ranges>
+#include <shared_mutex>
+#include <span>
+#include <sstream>
 #include <stdexcept>
+#include <string>
 #include <thread>
 #include <tuple>
 #include <type_traits>
+#include <unordered_map>
 #include <unordered_set>
 #include <utility>
 #include <vector>
 
+#ifdef QUILE_ENABLE_SHARED_MEMORY
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <system_error>
+#include <unistd.h>
+#endif
+
 /**
  * @mainpage Introduction
  *
@@ -73,7 +93,9 @@
  * Example compilation command: `g++ -std=c++20 -DNDEBUG -O3 -Wall -Wextra
  * -pedantic -I/home/user/repos/quile -pthread program.cc`. Clang compilation
  * flags are identical. Please remove `-DNDEBUG` to enable assertions. Please
- * add `-DQUILE_ENABLE_LOGGING` to enable logging.
+ * add `-DQUILE_ENABLE_LOGGING` to enable logging. Please add
+ * `-DQUILE_ENABLE_SHARED_MEMORY` to enable fitness function values cache
+ * shared between processes (POSIX systems only).
  *
  * Please note that examples from `doc/examples` directory were compiled with
  * following command `g++ -std=c++20 -DQUILE_ENABLE_LOGGING -O3 -Wall -Wextra
@@ -229,6 +251,9 @@ public:
    * @param policy Lauch policy (see `std::launch` documentation).
    * @param f Callable object to be concurrently executed.
    *
+   * @note Exception thrown by `f` is stored in returned future; thread is
+   * released for other callable objects anyway.
+   *
    * Example:
    * @include thread_pool_async.cc
    *
@@ -239,19 +264,32 @@ public:
   std::future<T> async(std::launch policy, const std::function<T()>& f)
   {
     return std::async(policy, [this, f]() {
-      acquire();
-      if constexpr (std::is_same_v<T, void>) {
-        f();
-        release();
-      } else {
-        const T res = f();
-        release();
-        return res;
-      }
+      const slot s{ *this };
+      return f();
     });
   }
 
 private:
+  // Thread acquired for the lifetime of the object, i.e. released also if
+  // executed callable object throws.
+  class slot
+  {
+  public:
+    explicit slot(thread_pool& tp)
+      : tp_{ tp }
+    {
+      tp_.acquire();
+    }
+
+    slot(const slot&) = delete;
+    slot& operator=(const slot&) = delete;
+
+    ~slot() { tp_.release(); }
+
+  private:
+    thread_pool& tp_;
+  };
+
   inline void acquire()
   {
     std::unique_lock<std::mutex> ul{ m_ };
@@ -272,6 +310,225 @@ private:
   std::size_t free_threads_;
 };
 
+////////////////////
+// Concurrent map //
+////////////////////
+
+/**
+ * `concurrent_unordered_map` is hash map safe for concurrent use. Keys are
+ * distributed among shards, each being `std::unordered_map` guarded by its own
+ * `std::shared_mutex`, so that readers never block each other and writers
+ * block only threads accessing the same shard. Values are returned by copy,
+ * hence each read observes state of the map either before or after any
+ * concurrent write, never in between.
+ *
+ * @tparam Key Key type.
+ * @tparam T Value type.
+ * @tparam Hash Hash function type.
+ * @tparam KeyEqual Key equality type.
+ *
+ * Example:
+ * @include concurrent_unordered_map.cc
+ *
+ * Result (might be different due to concurrent execution):
+ * @verbinclude concurrent_unordered_map.out
+ */
+template<typename Key,
+         typename T,
+         typename Hash = std::hash<Key>,
+         typename KeyEqual = std::equal_to<Key>>
+class concurrent_unordered_map
+{
+public:
+  /**
+   * `concurrent_unordered_map` constructor.
+   *
+   * @param shards Number of shards, i.e. independently locked parts of map.
+   *
+   * @throws std::invalid_argument If `shards` is zero.
+   */
+  explicit concurrent_unordered_map(std::size_t shards = 64)
+    : shards_{ shards }
+  {
+    if (shards == 0) {
+      throw std::invalid_argument{ "concurrent map: no shards" };
+    }
+  }
+
+  concurrent_unordered_map(const concurrent_unordered_map&) = delete;
+  concurrent_unordered_map& operator=(const concurrent_unordered_map&) =
+    delete;
+
+  /**
+   * `concurrent_unordered_map::insert_or_assign` inserts value `t` under key
+   * `key` or assigns it if the key already exists.
+   *
+   * @param key Key.
+   * @param t Value.
+   * @returns `true` if `t` was inserted, `false` if it was assigned.
+   */
+  bool insert_or_assign(const Key& key, const T& t)
+  {
+    auto& s = shards_[shard_index(Hash{}(key))];
+    const std::unique_lock<std::shared_mutex> ul{ s.m };
+    return s.map.insert_or_assign(key, t).second;
+  }
+
+  /**
+   * `concurrent_unordered_map::try_emplace` inserts value `t` under key `key`
+   * if the key does not exist yet.
+   *
+   * @param key Key.
+   * @param t Value.
+   * @returns `true` if `t` was inserted.
+   */
+  bool try_emplace(const Key& key, const T& t)
+  {
+    auto& s = shards_[shard_index(Hash{}(key))];
+    const std::unique_lock<std::shared_mutex> ul{ s.m };
+    return s.map.try_emplace(key, t).second;
+  }
+
+  /**
+   * `concurrent_unordered_map::find` returns copy of value stored under key
+   * `key`.
+   *
+   * @param key Key.
+   * @returns Value or `std::nullopt` if the key does not exist.
+   */
+  std::optional<T> find(const Key& key) const
+  {
+    const prehashed k{ key, Hash{}(key) };
+    const auto& s = shards_[shard_index(k.hash)];
+    const std::shared_lock<std::shared_mutex> sl{ s.m };
+    const auto it = s.map.find(k);
+    return it == s.map.end() ? std::nullopt : std::optional<T>{ it->second };
+  }
+
+  /**
+   * `concurrent_unordered_map::at` returns copy of value stored under key
+   * `key`.
+   *
+   * @param key Key.
+   * @returns Value.
+   *
+   * @throws std::out_of_range If the key does not exist.
+   */
+  T at(const Key& key) const
+  {
+    const prehashed k{ key, Hash{}(key) };
+    const auto& s = shards_[shard_index(k.hash)];
+    const std::shared_lock<std::shared_mutex> sl{ s.m };
+    const auto it = s.map.find(k);
+    if (it == s.map.end()) {
+      throw std::out_of_range{ "Key not found!" };
+    }
+    return it->second;
+  }
+
+  /**
+   * `concurrent_unordered_map::contains` checks if key `key` exists.
+   *
+   * @param key Key.
+   * @returns `true` if the key exists.
+   */
+  bool contains(const Key& key) const
+  {
+    const prehashed k{ key, Hash{}(key) };
+    const auto& s = shards_[shard_index(k.hash)];
+    const std::shared_lock<std::shared_mutex> sl{ s.m };
+    return s.map.contains(k);
+  }
+
+  /**
+   * `concurrent_unordered_map::erase` removes key `key` (if it exists).
+   *
+   * @param key Key.
+   * @returns `true` if the key was removed.
+   */
+  bool erase(const Key& key)
+  {
+    const prehashed k{ key, Hash{}(key) };
+    auto& s = shards_[shard_index(k.hash)];
+    const std::unique_lock<std::shared_mutex> ul{ s.m };
+    const auto it = s.map.find(k);
+    if (it == s.map.end()) {
+      return false;
+    }
+    s.map.erase(it);
+    return true;
+  }
+
+  /**
+   * `concurrent_unordered_map::size` returns number of elements. Shards are
+   * counted one by one, so result is exact only if there are no concurrent
+   * writes.
+   *
+   * @returns Number of elements.
+   */
+  std::size_t size() const
+  {
+    std::size_t res{ 0 };
+    for (const auto& s : shards_) {
+      const std::shared_lock<std::shared_mutex> sl{ s.m };
+      res += s.map.size();
+    }
+    return res;
+  }
+
+private:
+  // Key with its hash value, so that lookups (which use transparent hash and
+  // equality of shard maps) calculate hash value only once.
+  struct prehashed
+  {
+    const Key& key;
+    std::size_t hash;
+  };
+
+  struct shard_hash
+  {
+    using is_transparent = void;
+
+    std::size_t operator()(const Key& key) const { return Hash{}(key); }
+    std::size_t operator()(const prehashed& k) const { return k.hash; }
+  };
+
+  struct shard_equal
+  {
+    using is_transparent = void;
+
+    bool operator()(const Key& x, const Key& y) const
+    {
+      return KeyEqual{}(x, y);
+    }
+    bool operator()(const prehashed& x, const Key& y) const
+    {
+      return KeyEqual{}(x.key, y);
+    }
+    bool operator()(const Key& x, const prehashed& y) const
+    {
+      return KeyEqual{}(x, y.key);
+    }
+  };
+
+  struct shard_t
+  {
+    mutable std::shared_mutex m{};
+    std::unordered_map<Key, T, shard_hash, shard_equal> map{};
+  };
+
+  // Hash value is scrambled (Fibonacci hashing) before reduction modulo number
+  // of shards, otherwise keys of one shard would share low bits of hash value
+  // and hence buckets of `std::unordered_map`.
+  std::size_t shard_index(std::uint64_t h) const
+  {
+    return (h * 0x9E3779B97F4A7C15ull >> 32) % shards_.size();
+  }
+
+private:
+  std::vector<shard_t> shards_;
+};
+
 //////////////////////
 // Callable concept //
 //////////////////////
@@ -522,6 +779,39 @@ iota(T t)
  */
 using probability = double;
 
+namespace detail {
+
+// Engine used by `random_engine` in current thread instead of the global one
+// (if not `nullptr`).
+inline std::mt19937*&
+engine_override()
+{
+  static thread_local std::mt19937* engine{ nullptr };
+  return engine;
+}
+
+// Installs engine `e` as `random_engine` of current thread for the lifetime of
+// the object.
+class engine_scope
+{
+public:
+  explicit engine_scope(std::mt19937& e)
+    : previous_{ engine_override() }
+  {
+    engine_override() = &e;
+  }
+
+  engine_scope(const engine_scope&) = delete;
+  engine_scope& operator=(const engine_scope&) = delete;
+
+  ~engine_scope() { engine_override() = previous_; }
+
+private:
+  std::mt19937* previous_;
+};
+
+} // namespace detail
+
 /**
  * `random_engine` returns pseudo-random number generator engine based on
  * Mersenne Twister.
@@ -529,6 +819,10 @@ using probability = double;
  * @returns Reference to static object with Mersenne Twister engine
  * `std::mt19937` initialized with `std::random_device{}()`.
  *
+ * @note Concurrent parts of library (e.g. parallel `variation`) temporarily
+ * replace this engine in worker threads with their own engines seeded from
+ * the global one, so results depend only on the global engine seed.
+ *
  * Example:
  * @include random_engine.cc
  *
@@ -541,7 +835,8 @@ random_engine()
   // Only one global hidden variable engine (regardless of number of
   // translation units).
   static std::mt19937 engine{ std::random_device{}() };
-  return engine;
+  std::mt19937* e = detail::engine_override();
+  return e ? *e : engine;
 }
 
 /**
@@ -1034,6 +1329,40 @@ self_adaptive_variation_domain(const domain<T, N>& d, T lo)
   return res;
 }
 
+/**
+ * `one_sigma_self_adaptive_variation_domain` creates domain for self-adaptive
+ * mutation with one step size based on domain for ordinary variation.
+ *
+ * @tparam T Domain base type.
+ * @tparam N Domain dimensionality.
+ * @param d Domain to use.
+ * @param lo Minimum value for \f$\sigma\f$.
+ * @returns Domain with dimensionality of `N + 1`, where first part is equal to
+ * `d` and the last range is of form `range{ lo, 0.5 * m }`, where `m` is the
+ * maximum of `std::max(std::fabs(d[i].min()), std::fabs(d[i].max()))`.
+ *
+ * Example:
+ * @include self_adaptive_mutation.cc
+ *
+ * Result (might be different due to randomness):
+ * @verbinclude self_adaptive_mutation.out
+ */
+template<typename T, std::size_t N>
+requires std::floating_point<T>
+constexpr domain<T, N + 1>
+one_sigma_self_adaptive_variation_domain(const domain<T, N>& d, T lo)
+{
+  const T s = .5;
+  domain<T, N + 1> res{};
+  T m{ 0 };
+  for (std::size_t i = 0; i < N; ++i) {
+    res[i] = d[i];
+    m = std::max({ m, std::fabs(d[i].min()), std::fabs(d[i].max()) });
+  }
+  res[N] = range{ lo, s * m };
+  return res;
+}
+
 /**
  * `chain` represents genetic chain.
  *
@@ -1070,82 +1399,353 @@ chain_min(const domain<T, N>& d)
   return res;
 }
 
-//////////////
-// Genotype //
-//////////////
-
 /**
- * `g_floating_point` specifies that `genotype` has floating-point
- * representation.
+ * `chain_max` returns object of type `chain` filled at each `i` position with
+ * `d[i].max()` value.
  *
- * @tparam T Floating-point type of representation.
- * @tparam N Genotype length.
- * @tparam D Pointer to the genotype domain.
+ * @tparam T Chain base type.
+ * @tparam N Chain length.
+ * @param d Domain.
+ * @returns Chain based on `d`.
  *
  * Example:
- * @include g_floating_point.cc
+ * @include chain.cc
  *
  * Result (might be empty):
- * @verbinclude g_floating_point.out
+ * @verbinclude chain.out
  */
-template<typename T, std::size_t N, const domain<T, N>* D>
-requires std::floating_point<T>
-struct g_floating_point
+template<typename T, std::size_t N>
+chain<T, N>
+chain_max(const domain<T, N>& d)
 {
-  static_assert(D != nullptr);
-  static_assert(N > 0);
+  chain<T, N> res{};
+  std::ranges::transform(d, std::begin(res), std::identity{}, &range<T>::max);
+  return res;
+}
 
-  /**
-   * `g_floating_point::type` is floating-point type used for representing gene
-   * values.
-   *
-   * Example:
-   * @include g_floating_point.cc
-   *
-   * Result (might be empty):
-   * @verbinclude g_floating_point.out
-   */
-  using type = T;
+/////////////////////////
+// Packed binary chain //
+/////////////////////////
 
-  /**
-   * `size` returns domain size, i.e. `N`.
-   *
-   * @returns Genotype length (domain size).
-   *
-   * Example:
-   * @include g_floating_point.cc
-   *
-   * Result (might be empty):
-   * @verbinclude g_floating_point.out
-   */
-  static constexpr std::size_t size() { return N; }
+/**
+ * `packed_chain` represents binary genetic chain of length `N` packed into
+ * 64-bit words; gene at \em locus `i` is bit `i % 64` of word `i / 64`.
+ *
+ * @note Bits of the last word beyond \em locus `N - 1` are equal to zero.
+ *
+ * Example:
+ * @include packed_chain.cc
+ *
+ * Result (might be different due to randomness):
+ * @verbinclude packed_chain.out
+ */
+template<std::size_t N>
+using packed_chain = std::array<std::uint64_t, (N + 63) / 64>;
 
-  /**
-   * `constraints` returns domain, i.e. `*D`.
-   *
-   * @returns Domain.
-   *
-   * Example:
-   * @include g_floating_point.cc
-   *
-   * Result (might be empty):
-   * @verbinclude g_floating_point.out
-   */
-  static constexpr const domain<type, size()>& constraints() { return *D; }
+/**
+ * `pack` converts binary chain to packed chain.
+ *
+ * @tparam N Chain length.
+ * @param c Binary chain.
+ * @returns Packed chain.
+ *
+ * Example:
+ * @include packed_chain.cc
+ *
+ * Result (might be different due to randomness):
+ * @verbinclude packed_chain.out
+ */
+template<std::size_t N>
+packed_chain<N>
+pack(const chain<bool, N>& c)
+{
+  packed_chain<N> res{};
+  for (std::size_t i = 0; i < N; ++i) {
+    res[i / 64] |= std::uint64_t{ c[i] } << (i % 64);
+  }
+  return res;
+}
 
-  /**
-   * `g_floating_point::chain_t` is genetic chain type used as underlying
-   * representation in `genotype`.
-   *
-   * Example:
-   * @include g_floating_point.cc
-   *
-   * Result (might be empty):
-   * @verbinclude g_floating_point.out
-   */
-  using chain_t = chain<type, size()>;
+/**
+ * `unpack` converts packed chain to binary chain.
+ *
+ * @tparam N Chain length.
+ * @param p Packed chain.
+ * @returns Binary chain.
+ *
+ * Example:
+ * @include packed_chain.cc
+ *
+ * Result (might be different due to randomness):
+ * @verbinclude packed_chain.out
+ */
+template<std::size_t N>
+chain<bool, N>
+unpack(const packed_chain<N>& p)
+{
+  chain<bool, N> res{};
+  for (std::size_t i = 0; i < N; ++i) {
+    res[i] = (p[i / 64] >> (i % 64)) & 1;
+  }
+  return res;
+}
 
-  /**
+/**
+ * `segment_mask` returns packed chain of length `N` with bits set exactly at
+ * \em loci from `[first, last)` interval.
+ *
+ * @tparam N Chain length.
+ * @param first First \em locus of segment.
+ * @param last \em Locus following the last one of segment.
+ * @returns Mask.
+ *
+ * Example:
+ * @include packed_chain.cc
+ *
+ * Result (might be different due to randomness):
+ * @verbinclude packed_chain.out
+ */
+template<std::size_t N>
+packed_chain<N>
+segment_mask(std::size_t first, std::size_t last)
+{
+  const auto below = [](std::size_t i) {
+    return i % 64 == 0 ? std::uint64_t{ 0 }
+                       : ~std::uint64_t{ 0 } >> (64 - i % 64);
+  };
+  packed_chain<N> res{};
+  last = std::min(last, N);
+  if (first < last) {
+    const std::size_t w0 = first / 64;
+    const std::size_t w1 = (last - 1) / 64;
+    for (std::size_t w = w0; w <= w1; ++w) {
+      res[w] = ~std::uint64_t{ 0 };
+    }
+    res[w0] &= ~below(first);
+    if (last % 64 != 0) {
+      res[w1] &= below(last);
+    }
+  }
+  return res;
+}
+
+/**
+ * `uniform_mask` returns packed chain of length `N` with each bit set
+ * independently with probability \f$\frac{1}{2}\f$.
+ *
+ * @tparam N Chain length.
+ * @returns Mask.
+ *
+ * @note One pseudo-random 64-bit word is drawn per 64 genes.
+ *
+ * Example:
+ * @include packed_chain.cc
+ *
+ * Result (might be different due to randomness):
+ * @verbinclude packed_chain.out
+ */
+template<std::size_t N>
+packed_chain<N>
+uniform_mask()
+{
+  packed_chain<N> res{};
+  std::uniform_int_distribution<std::uint64_t> d{};
+  for (auto& w : res) {
+    w = d(random_engine());
+  }
+  res.back() &= segment_mask<N>(0, N).back();
+  return res;
+}
+
+namespace detail {
+
+// Calls `f(i)` for each `i` from `[0, n)` with probability `p`. Gaps between
+// successive \em loci are drawn from geometric distribution, so cost is
+// proportional to number of calls instead of `n`. Probability `p` so small
+// that `1 - p == 1` is treated as zero.
+template<typename F>
+void
+for_each_success(std::size_t n, probability p, F f)
+{
+  if (p >= 1.) {
+    for (std::size_t i = 0; i < n; ++i) {
+      f(i);
+    }
+  } else if (p > 0. && 1. - p < 1.) {
+    // Gaps are drawn (by inversion) as floating-point numbers and compared
+    // with number of remaining loci before conversion, since huge gaps are
+    // not representable in `std::size_t`.
+    const double l{ std::log1p(-p) };
+    std::uniform_real_distribution<double> u{ 0., 1. };
+    for (std::size_t i = 0;; ++i) {
+      const double gap{ std::floor(std::log1p(-u(random_engine())) / l) };
+      if (!(gap < static_cast<double>(n - i))) {
+        break;
+      }
+      i += static_cast<std::size_t>(gap);
+      f(i);
+    }
+  }
+}
+
+} // namespace detail
+
+/**
+ * `sparse_mask` returns packed chain of length `N` with each bit set
+ * independently with probability `p`.
+ *
+ * @tparam N Chain length.
+ * @param p Probability of setting bit.
+ * @returns Mask.
+ *
+ * @note Expected cost is proportional to number of set bits (plus mask
+ * length in words).
+ *
+ * Example:
+ * @include packed_chain.cc
+ *
+ * Result (might be different due to randomness):
+ * @verbinclude packed_chain.out
+ */
+template<std::size_t N>
+packed_chain<N>
+sparse_mask(probability p)
+{
+  packed_chain<N> res{};
+  detail::for_each_success(
+    N, p, [&res](std::size_t i) { res[i / 64] |= std::uint64_t{ 1 } << (i % 64); });
+  return res;
+}
+
+/**
+ * `exchange` swaps bits of packed chains `p0` and `p1` at \em loci set in
+ * mask `m`. It is word-level crossover kernel, e.g. with mask created by
+ * `segment_mask` it implements one-point or two-point crossover, and with
+ * mask created by `uniform_mask` it implements uniform crossover.
+ *
+ * @tparam W Number of words in packed chain.
+ * @param p0 First packed chain.
+ * @param p1 Second packed chain.
+ * @param m Mask.
+ *
+ * Example:
+ * @include packed_chain.cc
+ *
+ * Result (might be different due to randomness):
+ * @verbinclude packed_chain.out
+ */
+template<std::size_t W>
+void
+exchange(std::array<std::uint64_t, W>& p0,
+         std::array<std::uint64_t, W>& p1,
+         const std::array<std::uint64_t, W>& m)
+{
+  for (std::size_t i = 0; i < W; ++i) {
+    const std::uint64_t t = (p0[i] ^ p1[i]) & m[i];
+    p0[i] ^= t;
+    p1[i] ^= t;
+  }
+}
+
+/**
+ * `flip` negates bits of packed chain `p` at \em loci set in mask `m`. With
+ * mask created by `sparse_mask` it is word-level bit-flipping mutation kernel.
+ *
+ * @tparam W Number of words in packed chain.
+ * @param p Packed chain.
+ * @param m Mask.
+ *
+ * Example:
+ * @include packed_chain.cc
+ *
+ * Result (might be different due to randomness):
+ * @verbinclude packed_chain.out
+ */
+template<std::size_t W>
+void
+flip(std::array<std::uint64_t, W>& p, const std::array<std::uint64_t, W>& m)
+{
+  for (std::size_t i = 0; i < W; ++i) {
+    p[i] ^= m[i];
+  }
+}
+
+//////////////
+// Genotype //
+//////////////
+
+/**
+ * `g_floating_point` specifies that `genotype` has floating-point
+ * representation.
+ *
+ * @tparam T Floating-point type of representation.
+ * @tparam N Genotype length.
+ * @tparam D Pointer to the genotype domain.
+ *
+ * Example:
+ * @include g_floating_point.cc
+ *
+ * Result (might be empty):
+ * @verbinclude g_floating_point.out
+ */
+template<typename T, std::size_t N, const domain<T, N>* D>
+requires std::floating_point<T>
+struct g_floating_point
+{
+  static_assert(D != nullptr);
+  static_assert(N > 0);
+
+  /**
+   * `g_floating_point::type` is floating-point type used for representing gene
+   * values.
+   *
+   * Example:
+   * @include g_floating_point.cc
+   *
+   * Result (might be empty):
+   * @verbinclude g_floating_point.out
+   */
+  using type = T;
+
+  /**
+   * `size` returns domain size, i.e. `N`.
+   *
+   * @returns Genotype length (domain size).
+   *
+   * Example:
+   * @include g_floating_point.cc
+   *
+   * Result (might be empty):
+   * @verbinclude g_floating_point.out
+   */
+  static constexpr std::size_t size() { return N; }
+
+  /**
+   * `constraints` returns domain, i.e. `*D`.
+   *
+   * @returns Domain.
+   *
+   * Example:
+   * @include g_floating_point.cc
+   *
+   * Result (might be empty):
+   * @verbinclude g_floating_point.out
+   */
+  static constexpr const domain<type, size()>& constraints() { return *D; }
+
+  /**
+   * `g_floating_point::chain_t` is genetic chain type used as underlying
+   * representation in `genotype`.
+   *
+   * Example:
+   * @include g_floating_point.cc
+   *
+   * Result (might be empty):
+   * @verbinclude g_floating_point.out
+   */
+  using chain_t = chain<type, size()>;
+
+  /**
    * `valid` checks whether `c` belongs to the domain and returns `true` in that
    * case. Otherwise returns `false`.
    *
@@ -1608,9 +2208,16 @@ requires std::integral<T> &&(!std::is_same_v<T, bool>)struct g_permutation
    */
   static bool valid(const chain<type, size()>& c)
   {
-    const auto i = iota<type, size()>(M);
-    return contains(constraints(), c) &&
-           std::is_permutation(std::begin(c), std::end(c), std::begin(i));
+    // Membership bitmap gives linear time check instead of quadratic
+    // `std::is_permutation`.
+    std::array<bool, size()> seen{};
+    for (auto x : c) {
+      if (x < M || x > static_cast<type>(M + N - 1) || seen[x - M]) {
+        return false;
+      }
+      seen[x - M] = true;
+    }
+    return true;
   }
 
   /**
@@ -1625,6 +2232,19 @@ requires std::integral<T> &&(!std::is_same_v<T, bool>)struct g_permutation
    * @verbinclude g_permutation.out
    */
   static chain_t default_chain() { return iota<type, size()>(M); }
+
+  /**
+   * `lowest` returns the lowest permuted number, i.e. `M`.
+   *
+   * @returns The lowest permuted number.
+   *
+   * Example:
+   * @include g_permutation.cc
+   *
+   * Result (might be empty):
+   * @verbinclude g_permutation.out
+   */
+  static constexpr type lowest() { return M; }
 };
 
 /**
@@ -2258,6 +2878,40 @@ operator<<(std::ostream& os, const G& g)
   return os;
 }
 
+/**
+ * `operator>>` reads genotype from the stream, i.e. whitespace separated gene
+ * values in the format printed by `operator<<`.
+ *
+ * @param is Stream to use.
+ * @param g Genotype to be read.
+ * @returns Reference to the `is` stream.
+ *
+ * @throws std::invalid_argument Exception is raised if values read do not form
+ * valid genetic chain (cf. `genotype::genotype`).
+ *
+ * @note Genotype `g` is modified only if all gene values are read
+ * successfully.
+ *
+ * Example:
+ * @include genotype_stream.cc
+ *
+ * Result (might be different due to randomness):
+ * @verbinclude genotype_stream.out
+ */
+template<typename G>
+requires chromosome<G> std::istream&
+operator>>(std::istream& is, G& g)
+{
+  typename G::chain_t c{};
+  for (auto& x : c) {
+    is >> x;
+  }
+  if (is) {
+    g = G{ c };
+  }
+  return is;
+}
+
 } // namespace quile
 
 /**
@@ -2492,6 +3146,57 @@ template<typename G>
 requires chromosome<G>
 using recombination_fn = std::function<population<G>(const G&, const G&)>;
 
+/**
+ * `loci` is a sequence of gene \em loci, e.g. \em loci changed by mutation.
+ *
+ * Example:
+ * @include delta_fitness.cc
+ *
+ * Result (might be different due to randomness):
+ * @verbinclude delta_fitness.out
+ */
+using loci = std::vector<std::size_t>;
+
+/**
+ * `traced_mutation_fn` is a callable object which can be invoked on `genotype`
+ * and returns mutated genotype together with \em loci of genes changed by
+ * mutation.
+ *
+ * @note Returned \em loci may contain \em locus of gene, which was not
+ * changed, but each changed gene \em locus has to be present.
+ *
+ * Example:
+ * @include delta_fitness.cc
+ *
+ * Result (might be different due to randomness):
+ * @verbinclude delta_fitness.out
+ */
+template<typename G>
+requires chromosome<G>
+using traced_mutation_fn = std::function<std::tuple<G, loci>(const G&)>;
+
+/**
+ * `untraced` converts traced mutation `m` to ordinary mutation.
+ *
+ * @tparam G Some `genotype` specialization.
+ * @param m Traced mutation.
+ * @returns Mutation returning population consisting of genotype produced by
+ * `m`.
+ *
+ * Example:
+ * @include delta_fitness.cc
+ *
+ * Result (might be different due to randomness):
+ * @verbinclude delta_fitness.out
+ */
+template<typename G>
+requires chromosome<G>
+auto
+untraced(const traced_mutation_fn<G>& m)
+{
+  return [=](const G& g) { return population<G>{ std::get<0>(m(g)) }; };
+}
+
 /**
  * `unary_identity` is an identity mutation.
  *
@@ -2534,46 +3239,293 @@ binary_identity(const G& g0, const G& g1)
 }
 
 /**
- * `variation` represents variation operator.
+ * `in_place_mutation` specifies that `M` instance applied to (non-constant)
+ * object of type `genotype` mutates it in place.
  *
- * @tparam G Some `genotype` specialization.
+ * Example:
+ * @include in_place_variation.cc
  *
- * @note At the moment library supports only canonical forms of variations
- * (unary and binary).
+ * Result (might be different due to randomness):
+ * @verbinclude in_place_variation.out
+ */
+template<typename M, typename G>
+concept in_place_mutation = requires(M m, G& g)
+{
+  {
+    m(g)
+    } -> std::same_as<void>;
+}
+&&chromosome<G>;
+
+/**
+ * `in_place_mutation_fn` is a callable object which can be invoked on
+ * `genotype` and mutates it in place.
  *
  * Example:
- * @include variation.cc
+ * @include in_place_variation.cc
  *
  * Result (might be different due to randomness):
- * @verbinclude variation.out
+ * @verbinclude in_place_variation.out
  */
 template<typename G>
 requires chromosome<G>
-class variation
-{
-public:
-  /**
-   * `variation::variation` constructor creates object representing variation
-   * consisting of recombination `r` with mutation `m` applied separately to
-   * each child coming from `r`.
-   *
-   * @param m Mutation.
-   * @param r Recombination.
-   *
-   * Example:
-   * @include variation.cc
-   *
-   * Result (might be different due to randomness):
-   * @verbinclude variation.out
-   */
-  variation(const mutation_fn<G>& m, const recombination_fn<G>& r)
-    : m_{ m }
-    , r_{ r }
-  {
-  }
+using in_place_mutation_fn = std::function<void(G&)>;
 
-  /**
-   * `variation::variation` constructor creates identity variation.
+/**
+ * `in_place_recombination` specifies that `R` instance applied to two objects
+ * of type `genotype` (parents) and two objects of type `genotype` (slots for
+ * children) writes offspring to the slots and returns number of children (1 or
+ * 2).
+ *
+ * @note Slots for children must not refer to parents.
+ *
+ * Example:
+ * @include in_place_variation.cc
+ *
+ * Result (might be different due to randomness):
+ * @verbinclude in_place_variation.out
+ */
+template<typename R, typename G>
+concept in_place_recombination = requires(R r, const G& g, G& c)
+{
+  {
+    r(g, g, c, c)
+    } -> std::convertible_to<std::size_t>;
+}
+&&chromosome<G>;
+
+/**
+ * `in_place_recombination_fn` is a callable object which can be invoked on two
+ * objects of type `genotype` (parents) and two objects of type `genotype`
+ * (slots for children); it writes offspring to the slots and returns number of
+ * children.
+ *
+ * Example:
+ * @include in_place_variation.cc
+ *
+ * Result (might be different due to randomness):
+ * @verbinclude in_place_variation.out
+ */
+template<typename G>
+requires chromosome<G>
+using in_place_recombination_fn =
+  std::function<std::size_t(const G&, const G&, G&, G&)>;
+
+/**
+ * `in_place` converts mutation or recombination `x` to its in-place form.
+ * In-place forms are returned unchanged.
+ *
+ * @tparam G Some `genotype` specialization.
+ * @param x Mutation or recombination (ordinary or in-place).
+ * @returns In-place mutation or in-place recombination.
+ *
+ * @note Conversion of ordinary operator does not remove its intermediate
+ * population; library provides native in-place forms of the most common
+ * operators (e.g. `in_place_swap_mutation`, `in_place_uniform_xover`).
+ *
+ * Example:
+ * @include in_place_variation.cc
+ *
+ * Result (might be different due to randomness):
+ * @verbinclude in_place_variation.out
+ */
+template<typename G, typename X>
+requires mutation<X, G> || in_place_mutation<X, G> || recombination<X, G> ||
+  in_place_recombination<X, G>
+auto
+in_place(X x)
+{
+  if constexpr (in_place_mutation<X, G> || in_place_recombination<X, G>) {
+    return x;
+  } else if constexpr (mutation<X, G>) {
+    return [=](G& g) {
+      population<G> p = x(g);
+      g = std::move(p.at(0));
+    };
+  } else {
+    return [=](const G& g0, const G& g1, G& c0, G& c1) -> std::size_t {
+      population<G> p = x(g0, g1);
+      assert(p.size() == 1 || p.size() == 2);
+      c0 = std::move(p[0]);
+      if (p.size() == 2) {
+        c1 = std::move(p[1]);
+      }
+      return p.size();
+    };
+  }
+}
+
+namespace detail {
+
+// Ordinary form of in-place mutation `m`.
+template<typename G, typename M>
+requires in_place_mutation<M, G>
+auto
+out_of_place(M m)
+{
+  return [=](const G& g) {
+    population<G> res{ g };
+    m(res[0]);
+    return res;
+  };
+}
+
+// Ordinary form of in-place recombination `r`.
+template<typename G, typename R>
+requires in_place_recombination<R, G>
+auto
+out_of_place(R r)
+{
+  return [=](const G& g0, const G& g1) {
+    population<G> res{ g0, g1 };
+    res.resize(r(g0, g1, res[0], res[1]));
+    return res;
+  };
+}
+
+} // namespace detail
+
+/**
+ * `in_place_unary_identity` is an in-place identity mutation.
+ *
+ * @tparam G Some `genotype` specialization.
+ *
+ * Example:
+ * @include in_place_variation.cc
+ *
+ * Result (might be different due to randomness):
+ * @verbinclude in_place_variation.out
+ */
+template<typename G>
+requires chromosome<G>
+void
+in_place_unary_identity(G&)
+{
+}
+
+/**
+ * `in_place_binary_identity` is an in-place identity recombination.
+ *
+ * @tparam G Some `genotype` specialization.
+ * @param g0 Genotype (first parent).
+ * @param g1 Genotype (second parent).
+ * @param c0 Slot for the first child.
+ * @param c1 Slot for the second child.
+ * @returns Number of children (2).
+ *
+ * Example:
+ * @include in_place_variation.cc
+ *
+ * Result (might be different due to randomness):
+ * @verbinclude in_place_variation.out
+ */
+template<typename G>
+requires chromosome<G> std::size_t
+in_place_binary_identity(const G& g0, const G& g1, G& c0, G& c1)
+{
+  c0 = g0;
+  c1 = g1;
+  return 2;
+}
+
+namespace detail {
+
+// Parents varied by `variation` in current thread (if not `nullptr`), i.e.
+// parents of offspring recorded by adaptive operators.
+template<typename G>
+requires chromosome<G>
+inline std::array<const G*, 2>&
+varied_parents()
+{
+  static thread_local std::array<const G*, 2> parents{ nullptr, nullptr };
+  return parents;
+}
+
+// Installs `g0` and `g1` as varied parents of current thread for the lifetime
+// of the object.
+template<typename G>
+requires chromosome<G>
+class parents_scope
+{
+public:
+  parents_scope(const G& g0, const G& g1)
+    : previous_{ varied_parents<G>() }
+  {
+    varied_parents<G>() = { &g0, &g1 };
+  }
+
+  parents_scope(const parents_scope&) = delete;
+  parents_scope& operator=(const parents_scope&) = delete;
+
+  ~parents_scope() { varied_parents<G>() = previous_; }
+
+private:
+  std::array<const G*, 2> previous_;
+};
+
+} // namespace detail
+
+/**
+ * `variation` represents variation operator.
+ *
+ * @tparam G Some `genotype` specialization.
+ * @tparam M In-place mutation type; default type-erased form accepts any
+ * mutation.
+ * @tparam R In-place recombination type; default type-erased form accepts any
+ * recombination.
+ *
+ * @note At the moment library supports only canonical forms of variations
+ * (unary and binary).
+ *
+ * @note Variation is fused: recombination writes children directly to slots
+ * of resulting population and mutation is applied to them in place. Ordinary
+ * operators are converted by `in_place`.
+ *
+ * Example:
+ * @include variation.cc
+ *
+ * Result (might be different due to randomness):
+ * @verbinclude variation.out
+ */
+template<typename G,
+         typename M = in_place_mutation_fn<G>,
+         typename R = in_place_recombination_fn<G>>
+requires chromosome<G> && in_place_mutation<M, G> &&
+  in_place_recombination<R, G>
+class variation
+{
+public:
+  /**
+   * `variation::variation` constructor creates object representing variation
+   * consisting of recombination `r` with mutation `m` applied separately to
+   * each child coming from `r`.
+   *
+   * @param m Mutation (ordinary or in-place).
+   * @param r Recombination (ordinary or in-place).
+   * @param thread_sz Number of threads for concurrent variation of
+   * population. Default value is equal to 1.
+   *
+   * @note With `thread_sz` greater than 1, mutation and recombination have to
+   * be thread-safe.
+   *
+   * Example:
+   * @include variation.cc
+   *
+   * Result (might be different due to randomness):
+   * @verbinclude variation.out
+   */
+  template<typename M0, typename R0>
+  requires(mutation<M0, G> || in_place_mutation<M0, G>) &&
+    (recombination<R0, G> || in_place_recombination<R0, G>)
+      variation(M0 m, R0 r, unsigned int thread_sz = 1)
+    : m_{ in_place<G>(m) }
+    , r_{ in_place<G>(r) }
+    , thread_sz_{ thread_sz }
+  {
+  }
+
+  /**
+   * `variation::variation` constructor creates identity variation.
    *
    * Example:
    * @include variation.cc
@@ -2582,14 +3534,14 @@ public:
    * @verbinclude variation.out
    */
   variation()
-    : variation{ unary_identity<G>, binary_identity<G> }
+    : variation{ in_place_unary_identity<G>, in_place_binary_identity<G> }
   {
   }
 
   /**
    * `variation::variation` constructor creates variation equal to mutation `m`.
    *
-   * @param m Mutation.
+   * @param m Mutation (ordinary or in-place).
    *
    * Example:
    * @include variation.cc
@@ -2597,8 +3549,10 @@ public:
    * Result (might be different due to randomness):
    * @verbinclude variation.out
    */
-  explicit variation(const mutation_fn<G>& m)
-    : variation{ m, binary_identity<G> }
+  template<typename M0>
+  requires mutation<M0, G> || in_place_mutation<M0, G>
+  explicit variation(M0 m)
+    : variation{ m, in_place_binary_identity<G> }
   {
   }
 
@@ -2606,7 +3560,7 @@ public:
    * `variation::variation` constructor creates variation equal to recombination
    * `r`.
    *
-   * @param r Recombination.
+   * @param r Recombination (ordinary or in-place).
    *
    * Example:
    * @include variation.cc
@@ -2614,8 +3568,10 @@ public:
    * Result (might be different due to randomness):
    * @verbinclude variation.out
    */
-  explicit variation(const recombination_fn<G>& r)
-    : variation{ unary_identity<G>, r }
+  template<typename R0>
+  requires recombination<R0, G> || in_place_recombination<R0, G>
+  explicit variation(R0 r)
+    : variation{ in_place_unary_identity<G>, r }
   {
   }
 
@@ -2634,12 +3590,8 @@ public:
    */
   population<G> operator()(const G& g0, const G& g1) const
   {
-    QUILE_LOG("Variation: " << g0 << ", " << g1);
-    population<G> res{};
-    for (const auto& g : r_(g0, g1)) {
-      res.push_back(m_(g).at(0));
-    }
-    assert(res.size() == 1 || res.size() == 2);
+    population<G> res(2);
+    res.resize(vary(g0, g1, res[0], res[1]));
     return res;
   }
 
@@ -2653,6 +3605,13 @@ public:
    * @throws std::invalid_argument Exception is raised if population size is
    * odd.
    *
+   * @note This method is potentially concurrent. Pairs of parents are split
+   * into chunks of `chunk_sz` pairs; each chunk uses its own pseudo-random
+   * number generator engine seeded from `random_engine()` and writes offspring
+   * to its own slots. Chunks are varied in the same way by one or many threads,
+   * so result depends only on seed of `random_engine()`, not on number of
+   * threads.
+   *
    * Example:
    * @include variation.cc
    *
@@ -2664,21 +3623,110 @@ public:
     if (p.size() % 2) {
       throw std::invalid_argument{ "wrong population size" };
     }
-    population<G> res;
-    for (std::size_t i = 0; i < p.size(); i += 2) {
-      for (const auto& g : this->operator()(p[i], p[i + 1])) {
-        res.push_back(g);
+    const std::size_t pairs = p.size() / 2;
+    const std::size_t chunks = (pairs + chunk_sz - 1) / chunk_sz;
+    std::vector<std::uint_fast32_t> seeds(chunks);
+    for (auto& x : seeds) {
+      x = random_engine()();
+    }
+    population<G> res(p.size());
+    std::vector<std::size_t> counts(chunks);
+    const auto vary_chunk = [&](std::size_t c) {
+      std::mt19937 engine{ seeds[c] };
+      const detail::engine_scope es{ engine };
+      const std::size_t first = 2 * c * chunk_sz;
+      std::size_t k = first;
+      for (std::size_t i = first; i < std::min(p.size(), first + 2 * chunk_sz);
+           i += 2) {
+        k += vary(p[i], p[i + 1], res[k], res[k + 1]);
+      }
+      counts[c] = k - first;
+    };
+    if (thread_sz_ > 1 && chunks > 1) {
+      thread_pool tp{ thread_sz_ };
+      std::vector<std::future<void>> v{};
+      for (std::size_t c = 0; c < chunks; ++c) {
+        QUILE_LOG("Asynchronous variation (multithreaded)");
+        v.push_back(
+          tp.async<void>(std::launch::async, [&, c]() { vary_chunk(c); }));
+      }
+      for (auto& x : v) {
+        x.get();
+      }
+    } else {
+      for (std::size_t c = 0; c < chunks; ++c) {
+        vary_chunk(c);
       }
     }
+    std::size_t k = 0;
+    for (std::size_t c = 0; c < chunks; ++c) {
+      for (std::size_t i = 2 * c * chunk_sz; i < 2 * c * chunk_sz + counts[c];
+           ++i, ++k) {
+        if (k != i) {
+          res[k] = std::move(res[i]);
+        }
+      }
+    }
+    res.resize(k);
     assert(res.size() == p.size() / 2 || res.size() == p.size());
     return res;
   }
 
+  /**
+   * `variation::chunk_sz` is number of pairs of parents varied with one
+   * pseudo-random number generator engine (and by one task in concurrent
+   * variation of population).
+   */
+  static constexpr std::size_t chunk_sz = 16;
+
+private:
+  std::size_t vary(const G& g0, const G& g1, G& c0, G& c1) const
+  {
+    QUILE_LOG("Variation: " << g0 << ", " << g1);
+    const detail::parents_scope<G> ps{ g0, g1 };
+    const std::size_t n = r_(g0, g1, c0, c1);
+    assert(n == 1 || n == 2);
+    m_(c0);
+    if (n == 2) {
+      m_(c1);
+    }
+    return n;
+  }
+
 private:
-  mutation_fn<G> m_;
-  recombination_fn<G> r_;
+  M m_;
+  R r_;
+  unsigned int thread_sz_{ 1 };
 };
 
+/**
+ * `static_variation` creates variation with mutation `m` and recombination `r`
+ * stored without type erasure, so that calls of operators can be inlined.
+ *
+ * @tparam G Some `genotype` specialization.
+ * @param m Mutation (ordinary or in-place).
+ * @param r Recombination (ordinary or in-place).
+ * @param thread_sz Number of threads for concurrent variation of population.
+ * Default value is equal to 1.
+ * @returns Variation.
+ *
+ * Example:
+ * @include in_place_variation.cc
+ *
+ * Result (might be different due to randomness):
+ * @verbinclude in_place_variation.out
+ */
+template<typename G, typename M, typename R>
+requires(mutation<M, G> || in_place_mutation<M, G>) &&
+  (recombination<R, G> || in_place_recombination<R, G>)
+auto
+static_variation(M m, R r, unsigned int thread_sz = 1)
+{
+  using M1 = decltype(in_place<G>(m));
+  using R1 = decltype(in_place<G>(r));
+  return variation<G, M1, R1>{ m, r, thread_sz };
+}
+
 /**
  * `stochastic_mutation` creates stochastic mutation consisting of `m` applied
  * with probability `p`.
@@ -2766,9 +3814,9 @@ using termination_condition_fn =
  * generations.
  * @returns Generations produced during evolution (cf. `max_history` argument).
  */
-template<typename G>
+template<typename G, typename M, typename R>
 requires chromosome<G> generations<G>
-evolution(const variation<G> v,
+evolution(const variation<G, M, R>& v,
           const population<G>& first_generation,
           const populate_1_fn<G>& p1,
           const populate_2_fn<G>& p2,
@@ -2816,9 +3864,9 @@ evolution(const variation<G> v,
  *
  * @note Evolution result is saved in separate file (not included).
  */
-template<typename G>
+template<typename G, typename M, typename R>
 requires chromosome<G> generations<G>
-evolution(const variation<G>& v,
+evolution(const variation<G, M, R>& v,
           const populate_0_fn<G>& p0,
           const populate_1_fn<G>& p1,
           const populate_2_fn<G>& p2,
@@ -2831,6 +3879,107 @@ evolution(const variation<G>& v,
     v, p0(generation_sz), p1, p2, tc, parents_sz, max_history);
 }
 
+/////////////
+// History //
+/////////////
+
+/**
+ * `canonical_history` reads evolution history from stream `is` and returns
+ * distinct canonical forms of genotypes in order of their first occurrence.
+ * Each line of history starts with generation number followed by genotype
+ * (cf. `operator>>`), the rest of line is ignored. Canonical form, e.g.
+ * the minimal element of a symmetry class, is computed by `canonical`, so
+ * genotypes equivalent under the symmetry are reported once.
+ *
+ * @tparam G Some `genotype` specialization.
+ * @tparam C Canonicalizer type.
+ * @param is Stream with evolution history.
+ * @param canonical Canonicalizer, i.e. callable object returning canonical
+ * form of its argument.
+ * @param thread_sz Number of threads for concurrent parsing and
+ * canonicalization.
+ * @param chunk_sz Number of lines processed by one task.
+ * @returns Distinct canonical forms.
+ *
+ * @throws std::invalid_argument Exception is raised if some non-empty line
+ * does not start with generation number and valid genotype.
+ *
+ * @note Lines are read sequentially and processed in chunks on thread pool;
+ * each chunk removes its own duplicates with hash set, and chunk results are
+ * merged in order of chunks, so the result does not depend on `thread_sz`.
+ * `canonical` is called concurrently if `thread_sz` is greater than one.
+ *
+ * Example:
+ * @include canonical_history.cc
+ *
+ * Result (might be different due to randomness):
+ * @verbinclude canonical_history.out
+ */
+template<typename G, typename C>
+requires chromosome<G> && callable<C, G, const G&>
+population<G>
+canonical_history(std::istream& is,
+                  C canonical,
+                  std::size_t thread_sz = 1,
+                  std::size_t chunk_sz = 4096)
+{
+  using lines = std::vector<std::string>;
+  const auto process = [&canonical](const lines& ls) {
+    population<G> res{};
+    std::unordered_set<G> found{};
+    for (const auto& l : ls) {
+      std::istringstream iss{ l };
+      std::size_t generation{};
+      G g{};
+      if (!(iss >> generation >> g)) {
+        throw std::invalid_argument{ "bad history line" };
+      }
+      if (G h = canonical(std::as_const(g)); found.insert(h).second) {
+        res.push_back(std::move(h));
+      }
+    }
+    return res;
+  };
+  population<G> res{};
+  std::unordered_set<G> found{};
+  const auto merge = [&](const population<G>& p) {
+    for (const auto& g : p) {
+      if (found.insert(g).second) {
+        res.push_back(g);
+      }
+    }
+  };
+  thread_pool tp{ std::max<std::size_t>(thread_sz, 1) };
+  std::deque<std::future<population<G>>> pending{};
+  lines ls{};
+  const auto submit = [&]() {
+    const auto chunk = std::make_shared<const lines>(std::move(ls));
+    pending.push_back(tp.async<population<G>>(
+      std::launch::async, [&process, chunk]() { return process(*chunk); }));
+    ls = lines{};
+    // Bounded number of chunks in flight keeps memory usage limited.
+    while (pending.size() > 2 * thread_sz) {
+      merge(pending.front().get());
+      pending.pop_front();
+    }
+  };
+  for (std::string line{}; std::getline(is, line);) {
+    if (line.find_first_not_of(" \t\r") != std::string::npos) {
+      ls.push_back(std::move(line));
+    }
+    if (ls.size() == chunk_sz) {
+      submit();
+    }
+  }
+  if (!ls.empty()) {
+    submit();
+  }
+  for (auto& f : pending) {
+    merge(f.get());
+  }
+  return res;
+}
+
 //////////////////////
 // Fitness function //
 //////////////////////
@@ -2873,6 +4022,68 @@ template<typename G>
 requires chromosome<G>
 using fitness_function = std::function<fitness(const G&)>;
 
+/**
+ * `batch_fitness_function` computes fitness function values for all genotypes
+ * of population at once and returns them in order corresponding to the order
+ * of genotypes in population.
+ *
+ * @note From implementation point of view the `batch_fitness_function` should
+ * be thread-safe.
+ *
+ * Example:
+ * @include test_function_batch.cc
+ *
+ * Result (might be different due to randomness):
+ * @verbinclude test_function_batch.out
+ */
+template<typename G>
+requires chromosome<G>
+using batch_fitness_function = std::function<fitnesses(const population<G>&)>;
+
+/**
+ * `delta_fitness_fn` is a callable object which computes fitness function value
+ * for `child` genotype with use of fitness function value `parent_fitness` of
+ * genotype `parent` and \em loci `changed` of genes differing between these
+ * genotypes, i.e. it has signature `fitness(const G& parent, fitness
+ * parent_fitness, const G& child, const loci& changed)`.
+ *
+ * @note Incremental calculation should cost \f$O(k)\f$ for \f$k\f$ changed
+ * genes instead of full evaluation cost.
+ *
+ * Example:
+ * @include delta_fitness.cc
+ *
+ * Result (might be different due to randomness):
+ * @verbinclude delta_fitness.out
+ */
+template<typename G>
+requires chromosome<G>
+using delta_fitness_fn =
+  std::function<fitness(const G&, fitness, const G&, const loci&)>;
+
+/**
+ * `delta_fitness_function` specifies that `F` is fitness function, which
+ * additionally provides incremental evaluation through `delta` member function
+ * of signature described by `delta_fitness_fn`.
+ *
+ * Example:
+ * @include delta_fitness.cc
+ *
+ * Result (might be different due to randomness):
+ * @verbinclude delta_fitness.out
+ */
+template<typename F, typename G>
+concept delta_fitness_function =
+  chromosome<G> && requires(const F f, const G g, fitness v, const loci l)
+{
+  {
+    f(g)
+    } -> std::convertible_to<fitness>;
+  {
+    f.delta(g, v, g, l)
+    } -> std::convertible_to<fitness>;
+};
+
 /**
  * `incalculable` is a special value which can be used when given gentotype is
  * not proper (cf. `genotype_constraints`) or to signal some problem in
@@ -2881,26 +4092,145 @@ using fitness_function = std::function<fitness(const G&)>;
 const fitness incalculable = -std::numeric_limits<fitness>::infinity();
 
 /**
- * `fitness_db` is an intermediary object to fitness function values database.
+ * `cost_features_fn` is a callable object returning features of genotype (e.g.
+ * numbers of atoms of each element), which fitness function evaluation time
+ * depends on. Evaluation time is assumed to be linear function of features,
+ * non-decreasing in each of them.
  *
- * @tparam G Some `genotype` specialization.
- *
- * @note Intermediary objects own database through the `std::shared_ptr`.
+ * @note The number of features must be the same for all genotypes.
  *
  * Example:
- * @include fitness_db.cc
+ * @include cost_features.cc
  *
- * Result (might be different due to randomness):
- * @verbinclude fitness_db.out
+ * Result (might be different due to concurrent execution):
+ * @verbinclude cost_features.out
  */
 template<typename G>
 requires chromosome<G>
-class fitness_db
+using cost_features_fn = std::function<std::vector<double>(const G&)>;
+
+/**
+ * `schedule_statistics` describes concurrent calculations of fitness function
+ * values for population: measured makespan (wall time from start of the first
+ * calculation to the end of the last one) and makespans of list scheduling
+ * simulated with measured times of single calculations, both for order used
+ * and for FIFO order (order in which genotypes were found uncalculated). All
+ * values are in seconds.
+ *
+ * Example:
+ * @include cost_features.cc
+ *
+ * Result (might be different due to concurrent execution):
+ * @verbinclude cost_features.out
+ */
+struct schedule_statistics
 {
-private:
   /**
-   * `fitness_db::database` is an unordered map with genotypes as its keys and
-   * fitness function values as its values.
+   * Measured makespan.
+   */
+  double makespan{ 0. };
+
+  /**
+   * Simulated makespan of order used.
+   */
+  double simulated{ 0. };
+
+  /**
+   * Simulated makespan of FIFO order.
+   */
+  double fifo{ 0. };
+};
+
+namespace detail {
+
+// Makespan of list scheduling of jobs of given durations (in given order) on
+// `workers` identical workers, i.e. each job starts on the first free worker.
+inline double
+makespan(const std::vector<double>& durations, std::size_t workers)
+{
+  std::priority_queue<double, std::vector<double>, std::greater<double>> q{};
+  for (std::size_t i = 0; i < workers; ++i) {
+    q.push(0.);
+  }
+  double res{ 0. };
+  for (const auto d : durations) {
+    const double t{ q.top() + d };
+    q.pop();
+    q.push(t);
+    res = std::max(res, t);
+  }
+  return res;
+}
+
+// Solution of linear system `a * x = b` (Gaussian elimination with partial
+// pivoting), if matrix `a` (stored row by row) is not singular.
+inline std::optional<std::vector<double>>
+solve(std::vector<double> a, std::vector<double> b)
+{
+  const std::size_t n{ b.size() };
+  assert(a.size() == n * n);
+  double scale{ 0. };
+  for (const auto x : a) {
+    scale = std::max(scale, std::fabs(x));
+  }
+  for (std::size_t k = 0; k < n; ++k) {
+    std::size_t r{ k };
+    for (std::size_t i = k + 1; i < n; ++i) {
+      if (std::fabs(a[i * n + k]) > std::fabs(a[r * n + k])) {
+        r = i;
+      }
+    }
+    if (!(std::fabs(a[r * n + k]) > 1e-12 * scale)) {
+      return std::nullopt;
+    }
+    if (r != k) {
+      std::swap_ranges(std::begin(a) + r * n,
+                       std::begin(a) + (r + 1) * n,
+                       std::begin(a) + k * n);
+      std::swap(b[r], b[k]);
+    }
+    for (std::size_t i = k + 1; i < n; ++i) {
+      const double f{ a[i * n + k] / a[k * n + k] };
+      for (std::size_t j = k; j < n; ++j) {
+        a[i * n + j] -= f * a[k * n + j];
+      }
+      b[i] -= f * b[k];
+    }
+  }
+  std::vector<double> res(n);
+  for (std::size_t k = n; k-- > 0;) {
+    double s{ b[k] };
+    for (std::size_t j = k + 1; j < n; ++j) {
+      s -= a[k * n + j] * res[j];
+    }
+    res[k] = s / a[k * n + k];
+  }
+  return res;
+}
+
+} // namespace detail
+
+/**
+ * `fitness_db` is an intermediary object to fitness function values database.
+ *
+ * @tparam G Some `genotype` specialization.
+ *
+ * @note Intermediary objects own database through the `std::shared_ptr`.
+ *
+ * Example:
+ * @include fitness_db.cc
+ *
+ * Result (might be different due to randomness):
+ * @verbinclude fitness_db.out
+ */
+template<typename G>
+requires chromosome<G>
+class fitness_db
+{
+private:
+  /**
+   * `fitness_db::database` is an unordered map with genotypes as its keys and
+   * fitness function values as its values.
    */
   using database = std::unordered_map<G, fitness>;
 
@@ -2943,6 +4273,91 @@ public:
   {
   }
 
+  /**
+   * `fitness_db::fitness_db` constructor creates intermediary object to fitness
+   * function values database with support of incremental evaluation.
+   *
+   * @param f Fitness function with incremental evaluation.
+   * @param gc Predicate defining proper genotypes.
+   * @param thread_sz Number of threads for concurrent fitness function values
+   * calculations. Default value is equal to
+   * `std::thread::hardware_concurrency()`.
+   *
+   * @note Fitness function value of genotype registered with `descent` is
+   * calculated incrementally with `f.delta` if fitness function value of its
+   * parent is available in database. Otherwise `f` is used.
+   *
+   * Example:
+   * @include delta_fitness.cc
+   *
+   * Result (might be different due to randomness):
+   * @verbinclude delta_fitness.out
+   */
+  template<typename F>
+  requires delta_fitness_function<F, G>
+  explicit fitness_db(
+    const F& f,
+    const genotype_constraints<G> auto& gc,
+    unsigned int thread_sz = std::thread::hardware_concurrency())
+    : function_{ [=](const G& g) { return gc(g) ? f(g) : incalculable; } }
+    , delta_{ [=](const G& p, fitness pf, const G& c, const loci& l) {
+      return gc(c) ? f.delta(p, pf, c, l) : incalculable;
+    } }
+    , thread_sz_{ thread_sz }
+  {
+  }
+
+  /**
+   * `fitness_db::fitness_db` constructor creates intermediary object to fitness
+   * function values database with batch calculations.
+   *
+   * @param f Fitness function.
+   * @param bf Batch fitness function consistent with `f`.
+   * @param gc Predicate defining proper genotypes.
+   * @param thread_sz Number of threads for concurrent fitness function values
+   * calculations. Default value is equal to
+   * `std::thread::hardware_concurrency()`.
+   *
+   * @note Fitness function values missing in database for population are
+   * calculated with `bf` at once (one call per thread); `f` is used for
+   * single genotypes.
+   *
+   * Example:
+   * @include test_function_batch.cc
+   *
+   * Result (might be different due to randomness):
+   * @verbinclude test_function_batch.out
+   */
+  explicit fitness_db(
+    const fitness_function<G>& f,
+    const batch_fitness_function<G>& bf,
+    const genotype_constraints<G> auto& gc,
+    unsigned int thread_sz = std::thread::hardware_concurrency())
+    : function_{ [=](const G& g) { return gc(g) ? f(g) : incalculable; } }
+    , batch_{ [=](const population<G>& p) {
+      std::vector<bool> ok(p.size());
+      population<G> proper{};
+      for (std::size_t i = 0; i < p.size(); ++i) {
+        if ((ok[i] = gc(p[i]))) {
+          proper.push_back(p[i]);
+        }
+      }
+      const fitnesses fs = bf(proper);
+      if (fs.size() != proper.size()) {
+        throw std::invalid_argument{ "wrong number of fitness values" };
+      }
+      fitnesses res(p.size(), incalculable);
+      for (std::size_t i = 0, j = 0; i < p.size(); ++i) {
+        if (ok[i]) {
+          res[i] = fs[j++];
+        }
+      }
+      return res;
+    } }
+    , thread_sz_{ thread_sz }
+  {
+  }
+
   /**
    * Default copy constructor `fitness_db::fitness_db`.
    */
@@ -2961,7 +4376,9 @@ public:
    * @param g Genotype for which fitness function value is needed.
    * @returns Fitness function value for genotype `g`.
    *
-   * @note This method is non-concurrent.
+   * @note This method is non-concurrent, but it is thread-safe. Database is
+   * locked only for lookup and insertion, so calls for different genotypes
+   * from many threads are calculated concurrently.
    *
    * Example:
    * @include fitness_db.cc
@@ -2971,12 +4388,14 @@ public:
    */
   fitness operator()(const G& g) const
   {
-    const auto it{ fitness_values_->find(g) };
-    const bool b = it != fitness_values_->end();
-    const fitness res = b ? it->second : ((*fitness_values_)[g] = function_(g));
-    QUILE_LOG("Fitness value for ["
-              << g << "]: " << res
-              << (b ? " (taken from database)" : " (calculated on demand)"));
+    if (const auto x = lookup(g)) {
+      QUILE_LOG("Fitness value for [" << g << "]: " << *x
+                                      << " (taken from database)");
+      return *x;
+    }
+    const fitness res = store(g, evaluate(g));
+    QUILE_LOG("Fitness value for [" << g << "]: " << res
+                                    << " (calculated on demand)");
     return res;
   }
 
@@ -2990,7 +4409,7 @@ public:
    * @returns Fitness function values for genotypes from population `p` in order
    * corresponding to the order of genotypes in population itself.
    *
-   * @note This method is potentially concurrent.
+   * @note This method is potentially concurrent and it is thread-safe.
    *
    * Example:
    * @include fitness_db.cc
@@ -3000,7 +4419,9 @@ public:
    */
   fitnesses operator()(const population<G>& p) const
   {
-    if (thread_sz_ > 1 && p.size() > 1) {
+    if (batch_) {
+      batch_calculations(p);
+    } else if (thread_sz_ > 1 && p.size() > 1) {
       multithreaded_calculations(p);
     }
     fitnesses res{};
@@ -3021,13 +4442,20 @@ public:
    * Result (might be different due to randomness):
    * @verbinclude fitness_db.out
    */
-  std::size_t size() const { return fitness_values_->size(); }
+  std::size_t size() const
+  {
+    const std::lock_guard<std::mutex> lg{ *mtx_ };
+    return fitness_values_->size();
+  }
 
   /**
    * `fitness_db::begin` returns constant iterator to the begin of database.
    *
    * @returns Constant iterator to the begin of database.
    *
+   * @note Iteration must not overlap with calculations of fitness function
+   * values, which may insert to database.
+   *
    * Example:
    * @include fitness_db.cc
    *
@@ -3051,6 +4479,71 @@ public:
    */
   const_iterator end() const { return fitness_values_->end(); }
 
+  /**
+   * `fitness_db::inserted` returns genotypes inserted to database after the
+   * first `n` insertions, with their fitness function values, in order of
+   * insertion.
+   *
+   * @param n Number of insertions to skip.
+   * @returns Genotypes with fitness function values.
+   *
+   * @note Database only grows, so `size()` is the number of insertions and
+   * it can be remembered to get only genotypes inserted later.
+   *
+   * Example:
+   * @include fitness_db.cc
+   *
+   * Result (might be different due to randomness):
+   * @verbinclude fitness_db.out
+   */
+  std::vector<std::pair<G, fitness>> inserted(std::size_t n) const
+  {
+    const std::lock_guard<std::mutex> lg{ *mtx_ };
+    std::vector<std::pair<G, fitness>> res{};
+    for (std::size_t i = n; i < insertions_->size(); ++i) {
+      res.push_back(*(*insertions_)[i]);
+    }
+    return res;
+  }
+
+  /**
+   * `fitness_db::descent` registers genotype `child` as descendant of genotype
+   * `parent` differing at \em loci `changed`. This information is used for
+   * incremental evaluation of `child`.
+   *
+   * @param parent Parent genotype.
+   * @param child Child genotype.
+   * @param changed \em Loci of genes changed in `child` with respect to
+   * `parent`.
+   *
+   * @note Registration has no effect for database created without
+   * incremental evaluation support or if `child` is already in database.
+   * Registration is kept until `child` is evaluated, but at most
+   * `descents_capacity` the most recent registrations are kept (e.g. of
+   * genotypes never passed to selection).
+   *
+   * Example:
+   * @include delta_fitness.cc
+   *
+   * Result (might be different due to randomness):
+   * @verbinclude delta_fitness.out
+   */
+  void descent(const G& parent, const G& child, const loci& changed) const
+  {
+    if (!delta_ || parent == child) {
+      return;
+    }
+    if (!lookup(child)) {
+      descents_->add(parent, child, changed);
+    }
+  }
+
+  /**
+   * `fitness_db::descents_capacity` is maximal number of registrations of
+   * descents kept by database.
+   */
+  static constexpr std::size_t descents_capacity = 1 << 14;
+
   /**
    * `fitness_db::rank_order` returns all genotypes from database in descending
    * order of fitness function value.
@@ -3067,20 +4560,109 @@ public:
    */
   population<G> rank_order() const
   {
+    std::vector<std::pair<G, fitness>> v{};
+    {
+      const std::lock_guard<std::mutex> lg{ *mtx_ };
+      v.assign(std::begin(*fitness_values_), std::end(*fitness_values_));
+    }
+    std::ranges::sort(v, std::ranges::greater{}, &std::pair<G, fitness>::second);
     population<G> res{};
-    std::ranges::transform(*this,
-                           std::back_inserter(res),
-                           std::identity{},
-                           &database::value_type::first);
-    std::ranges::sort(res, [this](const G& g0, const G& g1) {
-      return this->operator()(g0) > this->operator()(g1);
-    });
+    std::ranges::transform(
+      v, std::back_inserter(res), &std::pair<G, fitness>::first);
     return res;
   }
 
+  /**
+   * `fitness_db::cost_features` sets features of genotypes used for prediction
+   * of fitness function evaluation time. Concurrent calculations start with
+   * genotypes of the longest predicted evaluation time (LPT scheduling).
+   * Prediction is linear in features, fitted by least squares to evaluation
+   * times measured in concurrent calculations; until it can be fitted, or if
+   * some fitted coefficient of feature is negative, sum of features is used.
+   *
+   * @param f Cost features. Default empty value means FIFO scheduling.
+   *
+   * @note Order of calculations is learned only for more than one feature,
+   * since any increasing linear function of single feature orders genotypes
+   * in descending order of the feature itself.
+   *
+   * @note Setting has effect for all copies of intermediary object and
+   * discards measurements made with previous features.
+   *
+   * Example:
+   * @include cost_features.cc
+   *
+   * Result (might be different due to concurrent execution):
+   * @verbinclude cost_features.out
+   */
+  void cost_features(const cost_features_fn<G>& f = {}) const
+  {
+    scheduler_->features(f);
+  }
+
+  /**
+   * `fitness_db::predicted_cost` returns predicted fitness function evaluation
+   * time of genotype `g` (in seconds), or sum of its features if prediction is
+   * not fitted yet, cf. `cost_features`.
+   *
+   * @param g Genotype.
+   * @returns Predicted cost or 0 if cost features are not set.
+   *
+   * Example:
+   * @include cost_features.cc
+   *
+   * Result (might be different due to concurrent execution):
+   * @verbinclude cost_features.out
+   */
+  double predicted_cost(const G& g) const
+  {
+    const auto f = scheduler_->features();
+    return f ? scheduler_->predictor()(f(g)) : 0.;
+  }
+
+  /**
+   * `fitness_db::last_schedule` returns statistics of the last concurrent
+   * calculations of fitness function values.
+   *
+   * @returns Schedule statistics.
+   *
+   * Example:
+   * @include cost_features.cc
+   *
+   * Result (might be different due to concurrent execution):
+   * @verbinclude cost_features.out
+   */
+  schedule_statistics last_schedule() const { return scheduler_->last(); }
+
 private:
+  std::optional<fitness> lookup(const G& g) const
+  {
+    const std::lock_guard<std::mutex> lg{ *mtx_ };
+    const auto it = fitness_values_->find(g);
+    return it == fitness_values_->end() ? std::nullopt
+                                        : std::optional<fitness>{ it->second };
+  }
+
+  // Value calculated concurrently by another thread is kept (and returned).
+  fitness store(const G& g, fitness x) const
+  {
+    const std::lock_guard<std::mutex> lg{ *mtx_ };
+    return emplace(g, x);
+  }
+
+  // Requires `mtx_` to be locked.
+  fitness emplace(const G& g, fitness x) const
+  {
+    const auto [it, b] = fitness_values_->try_emplace(g, x);
+    if (b) {
+      insertions_->push_back(&*it);
+    }
+    return it->second;
+  }
+
   auto uncalculated_fitnesses(const population<G>& p) const
   {
+    const std::lock_guard<std::mutex> lg{ *mtx_ };
     std::unordered_set<G> res{};
     std::ranges::copy_if(
       p, std::inserter(res, std::end(res)), [this](const G& g) {
@@ -3089,33 +4671,354 @@ private:
     return res;
   }
 
+  // Returns function computing fitness function value of `g` from scratch or
+  // incrementally with respect to its registered parent.
+  std::function<fitness()> evaluation(const G& g) const
+  {
+    if (delta_) {
+      if (const auto d = descents_->take(g)) {
+        const auto& [parent, changed] = *d;
+        if (const auto pf = lookup(parent); pf && *pf != incalculable) {
+          return [this, g, parent, changed, pf = *pf]() {
+            return delta_(parent, pf, g, changed);
+          };
+        }
+      }
+    }
+    return [this, g]() { return function_(g); };
+  }
+
+  fitness evaluate(const G& g) const { return evaluation(g)(); }
+
+  // Uncalculated genotypes are evaluated by `thread_sz_` workers taking them
+  // one by one from the list, which is sorted in descending order of predicted
+  // cost if cost features are given (longest processing time first).
   void multithreaded_calculations(const population<G>& p) const
   {
-    using type = std::pair<G, fitness>;
-    thread_pool tp{ thread_sz_ };
-    std::vector<std::future<type>> v{};
-    for (const auto& x : uncalculated_fitnesses(p)) {
-      QUILE_LOG("Asynchronous fitness value calculations (multithreaded)");
-      v.push_back(tp.async<type>(std::launch::async, [this, x]() {
-        const fitness xf = this->function_(x);
-        return type{ x, xf };
-      }));
+    const auto u = uncalculated_fitnesses(p);
+    population<G> jobs(std::begin(u), std::end(u));
+    if (jobs.empty()) {
+      return;
+    }
+    std::vector<std::size_t> order(jobs.size());
+    std::iota(std::begin(order), std::end(order), 0);
+    std::vector<std::vector<double>> xs(jobs.size());
+    const auto features = scheduler_->features();
+    if (features) {
+      std::ranges::transform(jobs, std::begin(xs), features);
+      const auto cost = scheduler_->predictor();
+      std::vector<double> cs(jobs.size());
+      std::ranges::transform(xs, std::begin(cs), cost);
+      std::ranges::stable_sort(
+        order, std::ranges::greater{}, [&](auto i) { return cs[i]; });
+    }
+    std::vector<std::function<fitness()>> fs{};
+    std::ranges::transform(jobs, std::back_inserter(fs), [this](const G& g) {
+      return evaluation(g);
+    });
+    fitnesses values(jobs.size());
+    std::vector<double> durations(jobs.size());
+    std::atomic<std::size_t> next{ 0 };
+    const std::size_t workers =
+      std::min<std::size_t>(std::max(thread_sz_, 1u), jobs.size());
+    const auto t0 = std::chrono::steady_clock::now();
+    {
+      thread_pool tp{ thread_sz_ };
+      std::vector<std::future<void>> v{};
+      for (std::size_t w = 0; w < workers; ++w) {
+        QUILE_LOG("Asynchronous fitness value calculations (multithreaded)");
+        v.push_back(tp.async<void>(std::launch::async, [&]() {
+          for (std::size_t k; (k = next++) < jobs.size();) {
+            const std::size_t i{ order[k] };
+            const auto t = std::chrono::steady_clock::now();
+            values[i] = fs[i]();
+            durations[i] = std::chrono::duration<double>(
+                             std::chrono::steady_clock::now() - t)
+                             .count();
+          }
+        }));
+      }
+      for (auto& x : v) {
+        x.get();
+      }
+    }
+    const double makespan{ std::chrono::duration<double>(
+                             std::chrono::steady_clock::now() - t0)
+                             .count() };
+    {
+      const std::lock_guard<std::mutex> lg{ *mtx_ };
+      for (std::size_t i = 0; i < jobs.size(); ++i) {
+        QUILE_LOG("Fitness value for ["
+                  << jobs[i] << "]: " << values[i]
+                  << " (calculated asynchronously on demand)");
+        emplace(jobs[i], values[i]);
+      }
+    }
+    std::vector<double> scheduled(jobs.size());
+    std::ranges::transform(order, std::begin(scheduled), [&](std::size_t i) {
+      return durations[i];
+    });
+    const schedule_statistics ss{ makespan,
+                                  detail::makespan(scheduled, workers),
+                                  detail::makespan(durations, workers) };
+    scheduler_->record(xs, durations, ss, features != nullptr);
+  }
+
+  void batch_calculations(const population<G>& p) const
+  {
+    const auto u = uncalculated_fitnesses(p);
+    const population<G> misses(std::begin(u), std::end(u));
+    if (misses.empty()) {
+      return;
     }
-    for (auto& x : v) {
-      const auto p = x.get();
-      QUILE_LOG("Fitness value for ["
-                << p.first << "]: " << p.second
-                << " (calculated asynchronously on demand)");
-      fitness_values_->insert(p);
+    const std::size_t slices =
+      std::min<std::size_t>(std::max(thread_sz_, 1u), misses.size());
+    const auto slice = [&](std::size_t i) {
+      return population<G>(std::begin(misses) + i * misses.size() / slices,
+                           std::begin(misses) +
+                             (i + 1) * misses.size() / slices);
+    };
+    std::vector<fitnesses> fs(slices);
+    if (slices == 1) {
+      QUILE_LOG("Batch fitness values calculations for " << misses.size()
+                                                         << " genotypes");
+      fs[0] = batch_(misses);
+    } else {
+      thread_pool tp{ thread_sz_ };
+      std::vector<std::future<void>> v{};
+      for (std::size_t i = 0; i < slices; ++i) {
+        QUILE_LOG("Asynchronous batch fitness values calculations "
+                  "(multithreaded)");
+        v.push_back(tp.async<void>(std::launch::async, [&, i]() {
+          fs[i] = batch_(slice(i));
+        }));
+      }
+      for (auto& x : v) {
+        x.get();
+      }
+    }
+    const std::lock_guard<std::mutex> lg{ *mtx_ };
+    for (std::size_t i = 0, k = 0; i < slices; ++i) {
+      for (auto x : fs[i]) {
+        QUILE_LOG("Fitness value for [" << misses[k] << "]: " << x
+                                        << " (calculated in batch)");
+        emplace(misses[k++], x);
+      }
     }
   }
 
+private:
+  // Registrations of descents (consumed by evaluation of child) in order of
+  // registration, so that the oldest ones are dropped above capacity.
+  class descent_registry
+  {
+  public:
+    void add(const G& parent, const G& child, const loci& changed)
+    {
+      const std::lock_guard<std::mutex> lg{ m_ };
+      descents_.insert_or_assign(child, entry{ parent, changed, ++n_ });
+      order_.emplace_back(child, n_);
+      while (order_.size() > descents_capacity) {
+        const auto& [g, n] = order_.front();
+        if (const auto it = descents_.find(g);
+            it != descents_.end() && it->second.n == n) {
+          descents_.erase(it);
+        }
+        order_.pop_front();
+      }
+    }
+
+    std::optional<std::tuple<G, loci>> take(const G& child)
+    {
+      const std::lock_guard<std::mutex> lg{ m_ };
+      const auto it = descents_.find(child);
+      if (it == descents_.end()) {
+        return std::nullopt;
+      }
+      std::tuple<G, loci> res{ std::move(it->second.parent),
+                               std::move(it->second.changed) };
+      descents_.erase(it);
+      return res;
+    }
+
+  private:
+    struct entry
+    {
+      G parent;
+      loci changed;
+      std::size_t n;
+    };
+
+    std::mutex m_{};
+    std::unordered_map<G, entry> descents_{};
+    std::deque<std::pair<G, std::size_t>> order_{};
+    std::size_t n_{ 0 };
+  };
+
+  // Cost features with linear model of evaluation time fitted incrementally
+  // (normal equations of least squares) and statistics of the last schedule.
+  class scheduler
+  {
+  public:
+    void features(const cost_features_fn<G>& f)
+    {
+      const std::lock_guard<std::mutex> lg{ m_ };
+      features_ = f;
+      n_ = 0;
+      ata_.clear();
+      atb_.clear();
+    }
+
+    cost_features_fn<G> features() const
+    {
+      const std::lock_guard<std::mutex> lg{ m_ };
+      return features_;
+    }
+
+    // Predicted cost: a_0 + sum of a_i * x_i with coefficients fitted to
+    // measurements (x, t) if there are more of them than coefficients.
+    std::function<double(const std::vector<double>&)> predictor() const
+    {
+      const auto sum = [](const std::vector<double>& x) {
+        return std::accumulate(std::begin(x), std::end(x), 0.);
+      };
+      std::optional<std::vector<double>> a{};
+      {
+        const std::lock_guard<std::mutex> lg{ m_ };
+        if (n_ > atb_.size()) {
+          a = detail::solve(ata_, atb_);
+        }
+      }
+      // Negative coefficients come from noisy (or misleading) measurements;
+      // keeping them would reverse order of calculations.
+      if (!a || std::any_of(std::begin(*a) + 1, std::end(*a), [](double c) {
+            return c < 0;
+          })) {
+        return sum;
+      }
+      return [a = *a](const std::vector<double>& x) {
+        assert(x.size() + 1 == a.size());
+        return std::inner_product(
+          std::begin(x), std::end(x), std::begin(a) + 1, a[0]);
+      };
+    }
+
+    void record(const std::vector<std::vector<double>>& xs,
+                const std::vector<double>& ts,
+                const schedule_statistics& ss,
+                bool fit)
+    {
+      const std::lock_guard<std::mutex> lg{ m_ };
+      if (fit) {
+        for (std::size_t i = 0; i < xs.size(); ++i) {
+          const std::size_t k{ xs[i].size() + 1 };
+          if (atb_.empty()) {
+            ata_.assign(k * k, 0.);
+            atb_.assign(k, 0.);
+          } else if (atb_.size() != k) {
+            throw std::invalid_argument{
+              "fitness db: inconsistent number of cost features"
+            };
+          }
+          const auto z = [&](std::size_t j) { return j ? xs[i][j - 1] : 1.; };
+          for (std::size_t r = 0; r < k; ++r) {
+            for (std::size_t c = 0; c < k; ++c) {
+              ata_[r * k + c] += z(r) * z(c);
+            }
+            atb_[r] += z(r) * ts[i];
+          }
+          ++n_;
+        }
+      }
+      last_ = ss;
+      QUILE_LOG("Schedule makespan: " << ss.makespan << " s (simulated: "
+                                      << ss.simulated
+                                      << " s, FIFO: " << ss.fifo << " s)");
+    }
+
+    schedule_statistics last() const
+    {
+      const std::lock_guard<std::mutex> lg{ m_ };
+      return last_;
+    }
+
+  private:
+    mutable std::mutex m_{};
+    cost_features_fn<G> features_{};
+    std::size_t n_{ 0 };
+    std::vector<double> ata_{};
+    std::vector<double> atb_{};
+    schedule_statistics last_{};
+  };
+
 private:
   fitness_function<G> function_;
+  batch_fitness_function<G> batch_{};
+  delta_fitness_fn<G> delta_{};
   unsigned int thread_sz_;
   std::shared_ptr<database> fitness_values_ = std::make_shared<database>();
+  // Elements of database (stable in unordered map) in order of insertion.
+  std::shared_ptr<std::vector<const typename database::value_type*>>
+    insertions_ = std::make_shared<
+      std::vector<const typename database::value_type*>>();
+  std::shared_ptr<descent_registry> descents_ =
+    std::make_shared<descent_registry>();
+  std::shared_ptr<std::mutex> mtx_ = std::make_shared<std::mutex>();
+  std::shared_ptr<scheduler> scheduler_ = std::make_shared<scheduler>();
 };
 
+/**
+ * `delta_mutation` creates mutation, which applies traced mutation `m` and
+ * registers descent of mutated genotype in database `fd`, enabling incremental
+ * evaluation of its fitness function value.
+ *
+ * @tparam G Some `genotype` specialization.
+ * @param m Traced mutation.
+ * @param fd Database intermediary object.
+ * @returns Mutation.
+ *
+ * @note Within `variation` mutated genotype is usually a child of
+ * recombination, with fitness function value never calculated. Descent is then
+ * registered against the parent of variation differing from mutated genotype
+ * at fewer \em loci (if they are not all \em loci).
+ *
+ * Example:
+ * @include delta_fitness.cc
+ *
+ * Result (might be different due to randomness):
+ * @verbinclude delta_fitness.out
+ */
+template<typename G>
+requires chromosome<G>
+auto
+delta_mutation(const traced_mutation_fn<G>& m, const fitness_db<G>& fd)
+{
+  return [=](const G& g) {
+    auto [child, changed] = m(g);
+    const auto [g0, g1] = detail::varied_parents<G>();
+    if (g0 == nullptr || g == *g0 || g == *g1) {
+      fd.descent(g, child, changed);
+    } else {
+      const auto differing = [&child](const G& parent) {
+        loci res{};
+        for (std::size_t i = 0; i < G::size(); ++i) {
+          if (parent.value(i) != child.value(i)) {
+            res.push_back(i);
+          }
+        }
+        return res;
+      };
+      const loci l0 = differing(*g0);
+      const loci l1 = differing(*g1);
+      const bool first = l0.size() <= l1.size();
+      if (const loci& l = first ? l0 : l1; l.size() < G::size()) {
+        fd.descent(first ? *g0 : *g1, child, l);
+      }
+    }
+    return population<G>{ std::move(child) };
+  };
+}
+
 /**
  * `print` prints to the stream `os` information about each genotype from each
  * generation accompanied with optional information about fitness function
@@ -3159,1314 +5062,4810 @@ print(std::ostream& os,
   }
 }
 
-/////////////////////////////
-// Selection probabilities //
-/////////////////////////////
+/**
+ * `fidelity_cascade` is fitness function composed of evaluators (levels) of
+ * increasing fidelity and cost, e.g. empirical model followed by \em ab
+ * \em initio calculations. Genotype moves to the next level only if its
+ * fitness function value at current level is calculable, reaches level
+ * threshold and is among level top fraction of values calculated at this level
+ * so far; otherwise it is rejected early and its fitness function value is
+ * `incalculable`. Fitness function value of genotype which passes all levels
+ * is its value at the last level.
+ *
+ * @tparam G Some `genotype` specialization.
+ *
+ * @note Each level has its own cache of fitness function values and counters
+ * of evaluations, cache hits and passed genotypes. Copies of object share
+ * them, hence object can be given to `fitness_db` as fitness function and
+ * inspected afterwards.
+ *
+ * @note Object is thread-safe if evaluators are thread-safe.
+ *
+ * Example:
+ * @include fidelity_cascade.cc
+ *
+ * Result (might be different due to randomness):
+ * @verbinclude fidelity_cascade.out
+ */
+template<typename G>
+requires chromosome<G>
+class fidelity_cascade
+{
+public:
+  /**
+   * `fidelity_cascade::level` describes one level of cascade.
+   */
+  struct level
+  {
+    /**
+     * Evaluator of this level.
+     */
+    fitness_function<G> f;
+
+    /**
+     * Minimum value needed to move to the next level.
+     */
+    fitness threshold = incalculable;
+
+    /**
+     * Fraction of best values (among values calculated at this level so far)
+     * moving to the next level.
+     */
+    probability top_fraction = 1.;
+
+    /**
+     * Cost of single evaluation in arbitrary units (e.g. seconds).
+     */
+    double cost = 1.;
+  };
+
+  /**
+   * `fidelity_cascade::fidelity_cascade` constructor.
+   *
+   * @param ls Levels in order of increasing fidelity. Threshold and top
+   * fraction of the last level are ignored.
+   *
+   * @throws std::invalid_argument If `ls` is empty or some top fraction is not
+   * in `(0, 1]`.
+   */
+  explicit fidelity_cascade(const std::vector<level>& ls)
+    : levels_{ ls }
+  {
+    if (ls.empty() || std::ranges::any_of(ls, [](const level& l) {
+          return !(l.top_fraction > 0 && l.top_fraction <= 1);
+        })) {
+      throw std::invalid_argument{ "fidelity cascade: bad levels" };
+    }
+    for (std::size_t i = 0; i < ls.size(); ++i) {
+      states_.push_back(std::make_shared<state>());
+    }
+  }
+
+  /**
+   * `fidelity_cascade::operator()` evaluates genotype `g` level by level until
+   * it is rejected or the last level is reached.
+   *
+   * @param g Genotype.
+   * @returns Fitness function value of the last level or `incalculable` if `g`
+   * was rejected.
+   */
+  fitness operator()(const G& g) const
+  {
+    for (std::size_t i = 0; i < levels_.size(); ++i) {
+      const fitness f{ value(i, g) };
+      if (i + 1 == levels_.size()) {
+        return f;
+      }
+      if (!passes(i, f)) {
+        QUILE_LOG("Fidelity cascade: [" << g << "] rejected at level " << i);
+        return incalculable;
+      }
+    }
+    return incalculable;
+  }
+
+  /**
+   * `fidelity_cascade::size` returns number of levels.
+   *
+   * @returns Number of levels.
+   */
+  std::size_t size() const { return levels_.size(); }
+
+  /**
+   * `fidelity_cascade::find` returns fitness function value of genotype `g`
+   * cached at level `i`.
+   *
+   * @param i Level.
+   * @param g Genotype.
+   * @returns Fitness function value or `std::nullopt` if `g` was not evaluated
+   * at level `i`.
+   */
+  std::optional<fitness> find(std::size_t i, const G& g) const
+  {
+    return states_.at(i)->cache.find(g);
+  }
+
+  /**
+   * `fidelity_cascade::evaluations` returns number of evaluations at level
+   * `i`.
+   *
+   * @param i Level.
+   * @returns Number of evaluations.
+   */
+  std::size_t evaluations(std::size_t i) const
+  {
+    return states_.at(i)->evaluations;
+  }
+
+  /**
+   * `fidelity_cascade::cache_hits` returns number of fitness function values
+   * at level `i` taken from cache.
+   *
+   * @param i Level.
+   * @returns Number of cache hits.
+   */
+  std::size_t cache_hits(std::size_t i) const
+  {
+    return states_.at(i)->cache_hits;
+  }
+
+  /**
+   * `fidelity_cascade::passed` returns number of genotypes, which moved from
+   * level `i` to the next one.
+   *
+   * @param i Level.
+   * @returns Number of passed genotypes.
+   */
+  std::size_t passed(std::size_t i) const { return states_.at(i)->passed; }
+
+  /**
+   * `fidelity_cascade::saved_cost` returns cost of evaluations avoided thanks
+   * to early rejection and caches, i.e. difference between cost of evaluation
+   * of all genotypes at all levels and actual cost.
+   *
+   * @returns Saved cost.
+   */
+  double saved_cost() const
+  {
+    double res{ 0. };
+    for (std::size_t i = 0; i < levels_.size(); ++i) {
+      const std::size_t requested{ evaluations(0) + cache_hits(0) };
+      res += levels_[i].cost * (requested - evaluations(i));
+    }
+    return res;
+  }
+
+private:
+  fitness value(std::size_t i, const G& g) const
+  {
+    auto& s = *states_[i];
+    if (const auto f = s.cache.find(g)) {
+      ++s.cache_hits;
+      return *f;
+    }
+    const fitness f{ levels_[i].f(g) };
+    ++s.evaluations;
+    s.cache.try_emplace(g, f);
+    return f;
+  }
+
+  // Calculable value `f` passes level `i` if it reaches threshold and number
+  // of greater values calculated at this level so far is below top fraction of
+  // them, i.e. if `f` is not less than the `m`-th greatest value, where `m` is
+  // the ceiling of top fraction of them. The `m` greatest values are kept in
+  // min-heap `top`, the rest in max-heap `rest`.
+  bool passes(std::size_t i, fitness f) const
+  {
+    if (f == incalculable) {
+      return false;
+    }
+    auto& s = *states_[i];
+    bool res{ f >= levels_[i].threshold };
+    {
+      const std::lock_guard<std::mutex> lg{ s.m };
+      if (!s.top.empty() && f > s.top.top()) {
+        s.top.push(f);
+      } else {
+        s.rest.push(f);
+      }
+      const auto n = s.top.size() + s.rest.size();
+      const auto m = static_cast<std::size_t>(
+        std::ceil(levels_[i].top_fraction * static_cast<double>(n)));
+      for (; s.top.size() > m; s.top.pop()) {
+        s.rest.push(s.top.top());
+      }
+      for (; s.top.size() < m && !s.rest.empty(); s.rest.pop()) {
+        s.top.push(s.rest.top());
+      }
+      res = res && f >= s.top.top();
+    }
+    if (res) {
+      ++s.passed;
+    }
+    return res;
+  }
+
+private:
+  struct state
+  {
+    concurrent_unordered_map<G, fitness> cache{};
+    std::atomic<std::size_t> evaluations{ 0 };
+    std::atomic<std::size_t> cache_hits{ 0 };
+    std::atomic<std::size_t> passed{ 0 };
+    std::mutex m{};
+    std::priority_queue<fitness, std::vector<fitness>, std::greater<fitness>>
+      top{};
+    std::priority_queue<fitness> rest{};
+  };
+
+  std::vector<level> levels_;
+  std::vector<std::shared_ptr<state>> states_{};
+};
 
 /**
- * `selection_probabilities` is a sequential container intended for keeping
- * selection probabilities values.
+ * `fitness_bound_fn` is a callable object, which receives upper bound of
+ * fitness function value reported by anytime fitness function during its
+ * calculations and returns `false` if calculations should be aborted.
  *
  * Example:
- * @include spf.cc
+ * @include anytime_evaluator.cc
  *
  * Result (might be different due to randomness):
- * @verbinclude spf.out
+ * @verbinclude anytime_evaluator.out
  */
-using selection_probabilities = std::vector<probability>;
+using fitness_bound_fn = std::function<bool(fitness)>;
 
 /**
- * `selection_probabilities_fn` is a callable object which can be invoked on
- * population and returns corresponding selection probabilities for each
- * genotype from population.
+ * `anytime_fitness_fn` is anytime fitness function, i.e. fitness function
+ * which reports improving (non-increasing) upper bounds of its value as it
+ * runs, e.g. iterative energy calculations or accumulated penalty. If callback
+ * returns `false`, calculations should be finished and the last reported
+ * bound returned.
  *
  * Example:
- * @include spf.cc
+ * @include anytime_evaluator.cc
  *
  * Result (might be different due to randomness):
- * @verbinclude spf.out
+ * @verbinclude anytime_evaluator.out
  */
 template<typename G>
 requires chromosome<G>
-using selection_probabilities_fn =
-  std::function<selection_probabilities(const population<G>&)>;
+using anytime_fitness_fn =
+  std::function<fitness(const G&, const fitness_bound_fn&)>;
 
 /**
- * `cumulative_probabilities` serves for calculation of cumulative selection
- * probabilities, which can be used later in roulette wheel selection or
- * stochastic universal sampling.
+ * `anytime_evaluator` is fitness function which runs anytime fitness function
+ * and aborts its calculations as soon as reported upper bound drops below
+ * cutoff, i.e. when genotype is provably worse than the worst genotype that
+ * matters for selection. Value of aborted calculations is the upper bound, not
+ * the exact fitness function value; such genotypes are remembered.
  *
  * @tparam G Some `genotype` specialization.
- * @param spf Selection probabilities function.
- * @param p Population.
- * @returns Cumulative selection probabilities.
- *
- * @note \em Cumulative selection probability for index `i` means sum of
- * selection probabilities from index `0` up to `i`. Cumulative selection
- * probability for last genotype in population is by definition equal to `1`.
  *
- * @note It is guaranteed that last cumulative probability in returned
- * container is equal to `1` without any numerical error.
+ * @note Copies of object share cutoff, bounds and counters, hence object can be
+ * given to `fitness_db` as fitness function and controlled afterwards (cf.
+ * `anytime_cutoff`).
  *
  * Example:
- * @include spf.cc
+ * @include anytime_evaluator.cc
  *
  * Result (might be different due to randomness):
- * @verbinclude spf.out
+ * @verbinclude anytime_evaluator.out
  */
 template<typename G>
-requires chromosome<G> selection_probabilities
-cumulative_probabilities(const selection_probabilities_fn<G>& spf,
-                         const population<G>& p)
+requires chromosome<G>
+class anytime_evaluator
 {
-  auto res = spf(p);
-  std::partial_sum(res.begin(), res.end(), res.begin());
-  // Last element should be exactly equal to 1. and another part of algorithm
-  // might require this exact identity. Unfortunately, numerical calculations
-  // might not be so precise. Let's check if last element is calculated with
-  // 1% precision (basic requirement):
-  assert(res.back() > .99 && res.back() < 1.01);
-  // Then, let's correct the value:
-  res.back() = 1.;
-  return res;
-}
+public:
+  /**
+   * `anytime_evaluator::anytime_evaluator` constructor.
+   *
+   * @param f Anytime fitness function.
+   * @param cutoff Initial cutoff. Default value `incalculable` means no
+   * aborts.
+   */
+  explicit anytime_evaluator(const anytime_fitness_fn<G>& f,
+                             fitness cutoff = incalculable)
+    : f_{ f }
+  {
+    state_->cutoff = cutoff;
+  }
 
-/**
- * `select_different_than` returns copy of container `c` with deleted elements
- * equal to `t`.
- *
- * @tparam C Container type.
- * @tparam T Type convertible to C container element type.
- * @param c Container.
- * @param t Element to be dropped in returned container.
- * @param require_nonempty_result Flag for possible exception.
- * @returns Container with values different than `t`.
- *
- * @throws std::runtime_error Exception is raised if `require_nonempty_result`
- * is `true` and returned container is empty.
- */
-template<typename C, typename T>
-C
-select_different_than(const C& c, T t, bool require_nonempty_result)
-{
-  C res{};
-  std::ranges::copy_if(
-    c, std::back_inserter(res), [=](auto x) { return x != t; });
-  if (require_nonempty_result && res.size() == 0) {
-    throw std::runtime_error{ "empty result" };
+  /**
+   * `anytime_evaluator::operator()` calculates fitness function value for
+   * genotype `g` or its upper bound if calculations are aborted.
+   *
+   * @param g Genotype.
+   * @returns Fitness function value or its upper bound below cutoff.
+   */
+  fitness operator()(const G& g) const
+  {
+    const fitness c{ state_->cutoff };
+    fitness bound{ std::numeric_limits<fitness>::infinity() };
+    bool aborted{ false };
+    const fitness res{ f_(g, [&](fitness b) {
+      bound = std::min(bound, b);
+      return !(aborted = bound < c);
+    }) };
+    if (!aborted) {
+      ++state_->completed;
+      return res;
+    }
+    ++state_->aborted;
+    const fitness b{ std::min(res, bound) };
+    state_->bounds.insert_or_assign(g, b);
+    QUILE_LOG("Anytime evaluation of [" << g << "] aborted with bound " << b);
+    return b;
+  }
+
+  /**
+   * `anytime_evaluator::cutoff` sets cutoff, i.e. value below which
+   * calculations are aborted.
+   *
+   * @param c Cutoff.
+   */
+  void cutoff(fitness c) const { state_->cutoff = c; }
+
+  /**
+   * `anytime_evaluator::cutoff` returns cutoff.
+   *
+   * @returns Cutoff.
+   */
+  fitness cutoff() const { return state_->cutoff; }
+
+  /**
+   * `anytime_evaluator::bound` returns upper bound of fitness function value
+   * of genotype `g`, if its calculations were aborted.
+   *
+   * @param g Genotype.
+   * @returns Upper bound or `std::nullopt` if there were no aborted
+   * calculations for `g`.
+   */
+  std::optional<fitness> bound(const G& g) const
+  {
+    return state_->bounds.find(g);
   }
-  return res;
-}
+
+  /**
+   * `anytime_evaluator::completed` returns number of completed calculations.
+   *
+   * @returns Number of completed calculations.
+   */
+  std::size_t completed() const { return state_->completed; }
+
+  /**
+   * `anytime_evaluator::aborted` returns number of aborted calculations.
+   *
+   * @returns Number of aborted calculations.
+   */
+  std::size_t aborted() const { return state_->aborted; }
+
+private:
+  struct state
+  {
+    std::atomic<fitness> cutoff{ incalculable };
+    concurrent_unordered_map<G, fitness> bounds{};
+    std::atomic<std::size_t> completed{ 0 };
+    std::atomic<std::size_t> aborted{ 0 };
+  };
+
+  anytime_fitness_fn<G> f_;
+  std::shared_ptr<state> state_{ std::make_shared<state>() };
+};
 
 /**
- * `select_calculable` returns container with fitness function values equal to
- * `fs`, but with `incalculable` entries skipped.
+ * `anytime_cutoff` extends selection to the next generation mechanism `p2`
+ * with setting cutoff of anytime evaluator `ae` to the fitness function value
+ * of the worst genotype of current generation before offspring are evaluated.
+ * Offspring provably worse than all survivors of current generation are thus
+ * evaluated only until it is proved.
  *
- * @param fs Fitness function values container.
- * @param require_nonempty_result Flag for possible exception.
- * @returns Container with values different than `incalculable`.
+ * @tparam G Some `genotype` specialization.
+ * @param p2 Selection to the next generation mechanism.
+ * @param fd Fitness function values database (using `ae`).
+ * @param ae Anytime evaluator.
+ * @returns Mechanism of `populate_2_fn` type.
  *
- * @throws std::runtime_error Exception is raised if `require_nonempty_result`
- * is `true` and returned container is empty.
+ * @note Bounds are exact enough for selections depending only on order of
+ * genotypes (e.g. `ranking_selection`) as long as each aborted genotype ranks
+ * below the whole current generation anyway; other selections see upper bound
+ * in place of (lower) exact value.
+ *
+ * Example:
+ * @include anytime_evaluator.cc
+ *
+ * Result (might be different due to randomness):
+ * @verbinclude anytime_evaluator.out
  */
-inline fitnesses
-select_calculable(const fitnesses& fs, bool require_nonempty_result = false)
+template<typename G>
+requires chromosome<G> populate_2_fn<G>
+anytime_cutoff(const populate_2_fn<G>& p2,
+               const fitness_db<G>& fd,
+               const anytime_evaluator<G>& ae)
 {
-  return select_different_than(fs, incalculable, require_nonempty_result);
+  return [=](std::size_t sz, const population<G>& p0, const population<G>& p1) {
+    const fitnesses fs{ fd(p0) };
+    const auto worst = std::ranges::min_element(fs);
+    ae.cutoff(worst == std::end(fs) ? incalculable : *worst);
+    return p2(sz, p0, p1);
+  };
 }
 
+#ifdef QUILE_ENABLE_SHARED_MEMORY
+
+/////////////////////////
+// Shared memory cache //
+/////////////////////////
+
 /**
- * `fitness_proportional_selection` is fitness proportional selection (a.k.a.
- * fitness \em proportionate selection) with windowing procedure (FPS).
+ * `shared_fitness_cache` is cache of fitness function values in POSIX shared
+ * memory segment, which can be attached by many processes, e.g. independent
+ * runs of evolution of the same problem on one machine. Value calculated by
+ * one process is then available to all of them.
+ *
+ * Cache is lock-free hash table with open addressing (linear probing) and
+ * fixed capacity. Slot is claimed with compare-and-swap of its tag and
+ * published with release store of genotype hash value after genotype and
+ * fitness function value are written; slots are never modified afterwards.
+ * Slot being written is skipped, hence process which died while writing does
+ * not block others, and the same genotype may rarely be stored twice.
  *
  * @tparam G Some `genotype` specialization.
  *
- * @note This implementation has workarounds for population of equally fit
- * genotypes and populations containing genotypes which fitnesses cannot be
- * calculated. Please note that there should be at least one genotype, which
- * fitness can be calculated.
+ * @note This class is available only if `QUILE_ENABLE_SHARED_MEMORY` token is
+ * defined.
+ *
+ * @note Copies of object share the mapping of segment, which is unmapped when
+ * the last copy is destroyed. Segment itself persists until `remove` is
+ * called.
  *
  * Example:
- * @include spf.cc
+ * @include shared_fitness_cache.cc
  *
  * Result (might be different due to randomness):
- * @verbinclude spf.out
+ * @verbinclude shared_fitness_cache.out
  */
 template<typename G>
-class fitness_proportional_selection
+requires chromosome<G> && std::is_trivially_copyable_v<typename G::chain_t>
+class shared_fitness_cache
 {
 public:
   /**
-   * `fitness_proportional_selection::fitness_proportional_selection`
-   * constructor creates FPS mechanism for database represented by intermediary
-   * object `ff`.
-   *
-   * @param ff Fitness database intermediary object.
+   * `shared_fitness_cache::shared_fitness_cache` constructor attaches shared
+   * memory segment `name`, creating it if needed.
    *
-   * Example:
-   * @include spf.cc
+   * @param name Name of segment (e.g. `/quile_cache`).
+   * @param capacity Maximum number of cached values (the same for all
+   * processes attaching the segment).
    *
-   * Result (might be different due to randomness):
-   * @verbinclude spf.out
+   * @throws std::system_error If segment cannot be opened, resized or mapped.
+   * @throws std::invalid_argument If `capacity` is zero or segment exists with
+   * different layout.
    */
-  explicit fitness_proportional_selection(const fitness_db<G>& ff)
-    : ff_{ ff }
+  shared_fitness_cache(const std::string& name, std::size_t capacity)
+    : segment_{ std::make_shared<segment>(name, capacity) }
   {
   }
 
   /**
-   * `fitness_proportional_selection::operator()` returns selection
-   * probabilities for population `p`.
+   * `shared_fitness_cache::remove` removes shared memory segment `name`.
+   * Processes which have attached it can still use it.
    *
-   * @param p Population.
-   * @returns FPS selection probabilities for population `p`.
-   *
-   * @throws std::runtime_error Exception is raised if fitness function
-   * evaluates to `incalculable` for all genotypes from `p`.
+   * @param name Name of segment.
+   */
+  static void remove(const std::string& name) { ::shm_unlink(name.c_str()); }
+
+  /**
+   * `shared_fitness_cache::find` returns cached fitness function value of
+   * genotype `g`.
    *
-   * Example:
-   * @include spf.cc
+   * @param g Genotype.
+   * @returns Fitness function value or `std::nullopt` if it is not cached.
+   */
+  std::optional<fitness> find(const G& g) const
+  {
+    const std::uint64_t t{ tag(g) };
+    const std::size_t n{ capacity() };
+    for (std::size_t k = 0, i = t % n; k < n; ++k, i = (i + 1) % n) {
+      slot& s = segment_->slots[i];
+      const std::uint64_t x{ std::atomic_ref<std::uint64_t>{ s.tag }.load(
+        std::memory_order_acquire) };
+      if (x == empty) {
+        return std::nullopt;
+      }
+      if (x == t && s.chain == g.data()) {
+        return s.value;
+      }
+    }
+    return std::nullopt;
+  }
+
+  /**
+   * `shared_fitness_cache::insert` caches fitness function value `f` of
+   * genotype `g`.
    *
-   * Result (might be different due to randomness):
-   * @verbinclude spf.out
+   * @param g Genotype.
+   * @param f Fitness function value.
+   * @returns `true` if value was inserted, `false` if it is already cached or
+   * cache is full.
    */
-  selection_probabilities operator()(const population<G>& p) const
+  bool insert(const G& g, fitness f) const
   {
-    const fitnesses fs{ ff_(p) };
-    const auto cal = select_calculable(fs, true);
-    const fitness min = *std::ranges::min_element(cal);
-    const auto n = cal.size(); // Value of n is guaranteed to be greater than 0.
-    const fitness delta = 1. / n;
-    const fitness sum =
-      std::accumulate(std::begin(cal), std::end(cal), fitness{ 0. }) - n * min +
-      1;
-    selection_probabilities res{};
-    std::ranges::transform(fs, std::back_inserter(res), [=](fitness f) {
-      return f == incalculable ? .0 : (f - min + delta) / sum;
-    });
-    return res;
+    const std::uint64_t t{ tag(g) };
+    const std::size_t n{ capacity() };
+    for (std::size_t k = 0, i = t % n; k < n; ++k, i = (i + 1) % n) {
+      slot& s = segment_->slots[i];
+      std::atomic_ref<std::uint64_t> a{ s.tag };
+      std::uint64_t x{ a.load(std::memory_order_acquire) };
+      if (x == empty &&
+          a.compare_exchange_strong(x, busy, std::memory_order_acquire)) {
+        s.chain = g.data();
+        s.value = f;
+        a.store(t, std::memory_order_release);
+        return true;
+      }
+      if (x == t && s.chain == g.data()) {
+        return false;
+      }
+    }
+    QUILE_LOG("Shared fitness cache is full");
+    return false;
+  }
+
+  /**
+   * `shared_fitness_cache::cached` returns fitness function, which takes
+   * values from the cache and calculates with `f` (and caches) only missing
+   * ones.
+   *
+   * @param f Fitness function.
+   * @returns Fitness function using the cache.
+   */
+  fitness_function<G> cached(const fitness_function<G>& f) const
+  {
+    return [c = *this, f](const G& g) {
+      if (const auto v = c.find(g)) {
+        QUILE_LOG("Fitness value for [" << g << "]: " << *v
+                                        << " (taken from shared memory)");
+        return *v;
+      }
+      const fitness v{ f(g) };
+      c.insert(g, v);
+      return v;
+    };
+  }
+
+  /**
+   * `shared_fitness_cache::capacity` returns maximum number of cached values.
+   *
+   * @returns Capacity.
+   */
+  std::size_t capacity() const { return segment_->capacity; }
+
+  /**
+   * `shared_fitness_cache::size` returns number of cached values.
+   *
+   * @returns Number of cached values.
+   *
+   * @note Complexity is linear in capacity.
+   */
+  std::size_t size() const
+  {
+    return static_cast<std::size_t>(std::ranges::count_if(
+      segment_->slots, segment_->slots + capacity(), [](slot& s) {
+        const auto x = std::atomic_ref<std::uint64_t>{ s.tag }.load(
+          std::memory_order_acquire);
+        return x != empty && x != busy;
+      }));
   }
 
 private:
-  const fitness_db<G> ff_;
+  static constexpr std::uint64_t empty{ 0 };
+  static constexpr std::uint64_t busy{ 1 };
+  static constexpr std::uint64_t magic{ 0x5155494C45434143ull };
+
+  struct slot
+  {
+    alignas(std::atomic_ref<std::uint64_t>::required_alignment)
+      std::uint64_t tag;
+    typename G::chain_t chain;
+    fitness value;
+  };
+
+  struct header
+  {
+    alignas(std::atomic_ref<std::uint64_t>::required_alignment)
+      std::uint64_t magic;
+    std::uint64_t capacity;
+    std::uint64_t slot_size;
+  };
+
+  static_assert(std::atomic_ref<std::uint64_t>::is_always_lock_free);
+
+  // Hash value of genotype scrambled by SplitMix64 finalizer, with the most
+  // significant bit set, so that it differs from `empty` and `busy`.
+  static std::uint64_t tag(const G& g)
+  {
+    std::uint64_t h{ std::hash<G>{}(g) };
+    h = (h ^ (h >> 30)) * 0xBF58476D1CE4E5B9ull;
+    h = (h ^ (h >> 27)) * 0x94D049BB133111EBull;
+    return (h ^ (h >> 31)) | 1ull << 63;
+  }
+
+  // Mapping of segment: header followed by slots.
+  struct segment
+  {
+    segment(const std::string& name, std::size_t n)
+      : capacity{ n }
+      , bytes{ sizeof(header) + n * sizeof(slot) }
+    {
+      if (n == 0) {
+        throw std::invalid_argument{ "shared fitness cache: zero capacity" };
+      }
+      const int fd{ ::shm_open(name.c_str(), O_CREAT | O_RDWR, 0600) };
+      if (fd == -1) {
+        throw std::system_error{ errno, std::generic_category(), "shm_open" };
+      }
+      struct ::stat st
+      {};
+      if (::fstat(fd, &st) == -1 ||
+          (static_cast<std::size_t>(st.st_size) < bytes &&
+           ::ftruncate(fd, static_cast<off_t>(bytes)) == -1)) {
+        const int e{ errno };
+        ::close(fd);
+        throw std::system_error{ e, std::generic_category(), "ftruncate" };
+      }
+      void* p{ ::mmap(
+        nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0) };
+      const int e{ errno };
+      ::close(fd);
+      if (p == MAP_FAILED) {
+        throw std::system_error{ e, std::generic_category(), "mmap" };
+      }
+      address = p;
+      auto* h = static_cast<header*>(p);
+      slots = reinterpret_cast<slot*>(static_cast<char*>(p) + sizeof(header));
+      // The first process writes layout, the others wait for it and check it.
+      std::atomic_ref<std::uint64_t> m{ h->magic };
+      std::uint64_t x{ empty };
+      if (m.compare_exchange_strong(x, busy)) {
+        h->capacity = n;
+        h->slot_size = sizeof(slot);
+        m.store(magic, std::memory_order_release);
+      } else {
+        while (m.load(std::memory_order_acquire) == busy) {
+          std::this_thread::yield();
+        }
+      }
+      if (m.load(std::memory_order_acquire) != magic || h->capacity != n ||
+          h->slot_size != sizeof(slot)) {
+        ::munmap(address, bytes);
+        throw std::invalid_argument{ "shared fitness cache: bad segment" };
+      }
+    }
+
+    segment(const segment&) = delete;
+    segment& operator=(const segment&) = delete;
+
+    ~segment() { ::munmap(address, bytes); }
+
+    std::size_t capacity;
+    std::size_t bytes;
+    void* address{ nullptr };
+    slot* slots{ nullptr };
+  };
+
+  std::shared_ptr<segment> segment_;
 };
 
+#endif // QUILE_ENABLE_SHARED_MEMORY
+
+/////////////////////
+// Surrogate model //
+/////////////////////
+
 namespace detail {
 
-/**
- * `detail::advance_cpy` wraps `std::advance` and returns iterator.
- *
- * @tparam It Iterator type.
- * @param it Iterator.
- * @param n Distance to advance.
- * @returns Advanced iterator.
- */
-template<typename It>
-It
-advance_cpy(It it, std::size_t n)
+// Features of genotype used by surrogate model: packed chain for binary
+// genotypes (Hamming distance by popcount), chain for permutations (Hamming
+// distance) and genes normalized to [0, 1] otherwise (Euclidean distance).
+template<typename G>
+requires chromosome<G>
+auto
+surrogate_features(const G& g)
 {
-  std::advance(it, n);
-  return it;
+  if constexpr (binary_chromosome<G>) {
+    return pack(g.data());
+  } else if constexpr (permutation_chromosome<G>) {
+    return g.data();
+  } else {
+    const auto& d = G::constraints();
+    std::array<double, G::size()> res{};
+    for (std::size_t i = 0; i < G::size(); ++i) {
+      const double w{ static_cast<double>(d[i].max()) - d[i].min() };
+      res[i] = w > 0 ? (g.value(i) - d[i].min()) / w : 0.;
+    }
+    return res;
+  }
 }
 
-/**
- * `detail::rank` returns ranking position of element in range after stable
- * sort.
- *
- * @tparam It Iterator type.
- * @tparam Compare Type of comparison mechanism.
- * @param first Range begin.
- * @param last Range end.
- * @param comp Comparison function object.
- * @returns Sequence container with ranking positions.
- */
-template<typename It, typename Compare = std::less<>>
-std::vector<std::size_t>
-rank(It first, It last, Compare comp = {})
+template<typename G>
+requires chromosome<G>
+using surrogate_features_t = decltype(surrogate_features(std::declval<G>()));
+
+template<typename G>
+requires chromosome<G>
+double
+surrogate_distance(const surrogate_features_t<G>& x,
+                   const surrogate_features_t<G>& y)
 {
-  std::vector<std::size_t> v(std::distance(first, last), 0);
-  std::ranges::generate(v, [i = std::size_t{ 0 }]() mutable { return i++; });
-  std::ranges::stable_sort(v, [first, &comp](auto a, auto b) {
-    return comp(*advance_cpy(first, a), *advance_cpy(first, b));
-  });
-  std::vector<std::size_t> res(v.size(), 0);
-  for (std::size_t i = 0; auto x : v) {
-    res.at(x) = i++;
+  double res{ 0. };
+  if constexpr (binary_chromosome<G>) {
+    for (std::size_t i = 0; i < x.size(); ++i) {
+      res += std::popcount(x[i] ^ y[i]);
+    }
+  } else if constexpr (permutation_chromosome<G>) {
+    for (std::size_t i = 0; i < x.size(); ++i) {
+      res += x[i] != y[i];
+    }
+  } else {
+    for (std::size_t i = 0; i < x.size(); ++i) {
+      res += square(x[i] - y[i]);
+    }
+    res = std::sqrt(res);
   }
   return res;
 }
 
-/**
- * `detail::id` performs identity operation between types.
- *
- * @tparam T Destination type.
- * @tparam U Source type.
- * @param u Argument.
- * @returns Argument after transformation to destination type.
- */
-template<typename T, typename U>
-T
-id(U u)
-{
-  return u;
-}
-
 } // namespace detail
 
 /**
- * `linear_ranking_selection` creates linear pressure mechanism for ranking
- * selection.
- *
- * @param s So-called \em s parameter.
- * @returns Linear pressure mechanism.
- *
- * Example:
- * @include spf.cc
- *
- * Result (might be different due to randomness):
- * @verbinclude spf.out
- */
-inline auto
-linear_ranking_selection(double s)
-{
-  return [s](std::size_t mu, std::size_t j) -> probability {
-    assert(mu > 0 && 1. < s && s <= 2. && j < mu);
-    const auto id = detail::id<probability, std::size_t>;
-    return mu == 1
-             ? 1.
-             : (2 - s) / id(mu) + 2 * id(j) * (s - 1) / (id(mu) * (id(mu) - 1));
-  };
-}
-
-/**
- * `exponential_ranking_selection` is exponential pressure mechanism for ranking
- * selection.
+ * `knn_surrogate` is surrogate model of fitness function, i.e. cheap
+ * approximation of it fitted to fitness function values already calculated.
+ * Fitness function value is predicted as mean of values of `k` nearest
+ * genotypes weighted by inverse distance. Distance is Euclidean for genes
+ * normalized to `[0, 1]` (floating-point and integer genotypes) or Hamming
+ * distance (binary and permutation genotypes).
  *
- * Example:
- * @include spf.cc
+ * @tparam G Some `genotype` specialization.
  *
- * Result (might be different due to randomness):
- * @verbinclude spf.out
- */
-inline probability
-exponential_ranking_selection(std::size_t mu, std::size_t j)
-{
-  assert(mu > 0 && j < mu);
-  const auto e = std::numbers::e_v<probability>;
-  const auto id = detail::id<probability, std::size_t>;
-  // Consider difference between -id(mu) and -mu for std::size_t mu.
-  return mu == 1 ? 1.
-                 : (1. - std::exp(-id(j))) * (1. - e) /
-                     (id(mu) * (1. - e) + e - std::exp(1 - id(mu)));
-}
-
-/**
- * `ranking_selection` is ranking selection (RS) mechanism.
+ * @note Model is fitted incrementally, i.e. `update` adds only genotypes
+ * calculated since its previous call. Each such genotype, for which value was
+ * predicted in the meantime, is used to estimate prediction error.
  *
- * @note This implementation has workarounds for populations containing
- * genotypes which fitnesses cannot be calculated. Please note that there should
- * be at least one genotype, which fitness can be calculated.
+ * @note Copies of object share the model.
  *
  * Example:
- * @include spf.cc
+ * @include knn_surrogate.cc
  *
  * Result (might be different due to randomness):
- * @verbinclude spf.out
+ * @verbinclude knn_surrogate.out
  */
 template<typename G>
-class ranking_selection
+requires chromosome<G>
+class knn_surrogate
 {
-private:
-  using probability_fn = std::function<probability(std::size_t, std::size_t)>;
-
 public:
   /**
-   * `ranking_selection::ranking_selection` constructor creates RS.
-   *
-   * @param ff Fitness function database intermediary object.
-   * @param pf Selection pressure mechanism (linear or exponential).
+   * `knn_surrogate::knn_surrogate` constructor.
    *
-   * Example:
-   * @include spf.cc
+   * @param k Number of nearest neighbors.
+   * @param thread_sz Number of threads for concurrent predictions. Default
+   * value is equal to `std::thread::hardware_concurrency()`.
    *
-   * Result (might be different due to randomness):
-   * @verbinclude spf.out
+   * @throws std::invalid_argument If `k` is zero.
    */
-  ranking_selection(const fitness_db<G>& ff, const probability_fn& pf)
-    : ff_{ ff }
-    , pf_{ pf }
+  explicit knn_surrogate(
+    std::size_t k = 5,
+    unsigned int thread_sz = std::thread::hardware_concurrency())
+    : k_{ k }
+    , thread_sz_{ thread_sz }
   {
+    if (k == 0) {
+      throw std::invalid_argument{ "surrogate: no neighbors" };
+    }
   }
 
   /**
-   * `ranking_selection::operator()` returns selection probabilities for
-   * population `p`.
+   * `knn_surrogate::update` adds genotypes inserted to database `fd` since
+   * previous call to training set of the model. Genotypes with `incalculable`
+   * fitness function value are omitted. Predictions made since previous call
+   * are validated and forgotten.
    *
-   * @param p Population.
-   * @returns RS selection probabilities for population `p`.
-   *
-   * @throws std::runtime_error Exception is raised if fitness function
-   * evaluates to `incalculable` for all genotypes from `p`.
-   *
-   * Example:
-   * @include spf.cc
+   * @param fd Database intermediary object.
    *
-   * Result (might be different due to randomness):
-   * @verbinclude spf.out
+   * @note Model has to be updated from one database (or its copies); only
+   * insertions since previous call are visited.
    */
-  selection_probabilities operator()(const population<G>& p) const
+  void update(const fitness_db<G>& fd) const
   {
-    const fitnesses fs{ ff_(p) };
-    auto r = detail::rank(
-      std::begin(p), std::end(p), [&](const auto& a, const auto& b) {
-        return ff_(a) < ff_(b);
-      });
-    const auto mu = select_calculable(fs, true).size();
-    const auto nq = p.size() - mu;
-    selection_probabilities res{};
-    std::ranges::transform(r, std::back_inserter(res), [=, this](auto j) {
-      return j < nq ? 0. : pf_(mu, j - nq);
-    });
-    return res;
+    const std::lock_guard<std::mutex> lg{ model_->m };
+    const auto inserted = fd.inserted(model_->insertions);
+    model_->insertions += inserted.size();
+    for (const auto& [g, f] : inserted) {
+      if (const auto it = model_->predictions.find(g);
+          it != model_->predictions.end()) {
+        if (std::isfinite(f)) {
+          model_->absolute_error += std::abs(it->second - f);
+          ++model_->validated;
+        }
+        model_->predictions.erase(it);
+      }
+      if (std::isfinite(f)) {
+        model_->features.push_back(detail::surrogate_features(g));
+        model_->values.push_back(f);
+      }
+    }
+    model_->predictions.clear();
   }
 
-private:
-  const fitness_db<G> ff_;
-  const probability_fn pf_;
-};
-
-////////////////////////////
-// Generators & selectors //
-////////////////////////////
+  /**
+   * `knn_surrogate::operator()` predicts fitness function values for genotypes
+   * from population `p`.
+   *
+   * @param p Population.
+   * @returns Predicted fitness function values in order corresponding to the
+   * order of genotypes in population `p`; `incalculable` if training set is
+   * empty.
+   *
+   * @note This method is potentially concurrent.
+   */
+  fitnesses operator()(const population<G>& p) const
+  {
+    const std::lock_guard<std::mutex> lg{ model_->m };
+    fitnesses res(p.size(), incalculable);
+    if (model_->values.empty()) {
+      return res;
+    }
+    const std::size_t chunks =
+      std::min<std::size_t>(std::max(thread_sz_, 1u), p.size());
+    const auto predict_chunk = [&](std::size_t c) {
+      for (std::size_t i = c * p.size() / chunks;
+           i < (c + 1) * p.size() / chunks;
+           ++i) {
+        res[i] = predict(detail::surrogate_features(p[i]));
+      }
+    };
+    if (chunks == 1) {
+      predict_chunk(0);
+    } else {
+      thread_pool tp{ thread_sz_ };
+      std::vector<std::future<void>> v{};
+      for (std::size_t c = 0; c < chunks; ++c) {
+        v.push_back(tp.async<void>(std::launch::async,
+                                   [&, c]() { predict_chunk(c); }));
+      }
+      for (auto& x : v) {
+        x.get();
+      }
+    }
+    for (std::size_t i = 0; i < p.size(); ++i) {
+      model_->predictions.insert_or_assign(p[i], res[i]);
+    }
+    return res;
+  }
 
-namespace detail {
+  /**
+   * `knn_surrogate::size` returns size of training set.
+   *
+   * @returns Number of genotypes in training set.
+   */
+  std::size_t size() const
+  {
+    const std::lock_guard<std::mutex> lg{ model_->m };
+    return model_->values.size();
+  }
 
-/**
- * `detail::generate` creates population of size `lambda` filled with result of
- * function `f`.
- *
- * @tparam G Some `genotype` specialization.
- * @param lambda Result population size.
- * @param f Function returning genotype.
- * @returns Population of size `lambda` where each member is result of `f`.
- */
-template<typename G>
-requires chromosome<G> population<G>
-generate(std::size_t lambda, const std::function<G()>& f)
-{
-  population<G> res{};
-  std::generate_n(std::back_inserter(res), lambda, f);
-  return res;
-}
+  /**
+   * `knn_surrogate::validated` returns number of predictions compared so far
+   * with fitness function values calculated afterwards.
+   *
+   * @returns Number of validated predictions.
+   */
+  std::size_t validated() const
+  {
+    const std::lock_guard<std::mutex> lg{ model_->m };
+    return model_->validated;
+  }
 
-} // namespace detail
+  /**
+   * `knn_surrogate::mean_absolute_error` returns mean absolute error of
+   * validated predictions.
+   *
+   * @returns Mean absolute error (zero if there are no validated predictions
+   * yet).
+   *
+   * @note Only predictions for genotypes evaluated afterwards are validated.
+   * In `surrogate_screening` offspring screened out are never evaluated, so
+   * error is measured on offspring with the highest predicted values only
+   * and it is biased estimate of error for all offspring.
+   */
+  double mean_absolute_error() const
+  {
+    const std::lock_guard<std::mutex> lg{ model_->m };
+    return model_->validated ? model_->absolute_error / model_->validated : 0.;
+  }
+
+private:
+  using features_t = detail::surrogate_features_t<G>;
+
+  fitness predict(const features_t& x) const
+  {
+    // Nearest neighbors (distance, value) sorted by distance.
+    std::vector<std::pair<double, fitness>> nn{};
+    const std::size_t k{ std::min(k_, model_->values.size()) };
+    nn.reserve(k + 1);
+    for (std::size_t j = 0; j < model_->values.size(); ++j) {
+      const double d{ detail::surrogate_distance<G>(x, model_->features[j]) };
+      if (nn.size() == k && d >= nn.back().first) {
+        continue;
+      }
+      nn.insert(std::ranges::upper_bound(
+                  nn, d, {}, &std::pair<double, fitness>::first),
+                { d, model_->values[j] });
+      if (nn.size() > k) {
+        nn.pop_back();
+      }
+    }
+    if (nn.front().first == 0) {
+      return nn.front().second;
+    }
+    double w{ 0. };
+    double res{ 0. };
+    for (const auto& [d, f] : nn) {
+      w += 1. / d;
+      res += f / d;
+    }
+    return res / w;
+  }
+
+private:
+  struct model
+  {
+    std::mutex m{};
+    std::size_t insertions{ 0 };
+    std::vector<features_t> features{};
+    fitnesses values{};
+    std::unordered_map<G, fitness> predictions{};
+    double absolute_error{ 0. };
+    std::size_t validated{ 0 };
+  };
+
+  std::size_t k_;
+  unsigned int thread_sz_;
+  std::shared_ptr<model> model_{ std::make_shared<model>() };
+};
 
 /**
- * `adapter` implements \em flatten function between `populate_2_fn` mechanism
- * and `populate_1_fn` mechanism.
+ * `surrogate_screening` extends selection to the next generation mechanism
+ * `p2` with pre-screening of offspring by surrogate model `s`: only fraction
+ * `fraction` of offspring with the highest predicted fitness function values
+ * is passed to `p2`, hence evaluated by fitness function, the rest is
+ * discarded. Model is updated from database `fd` before each screening.
  *
  * @tparam G Some `genotype` specialization.
- * @param fn Mechanism of `populate_1_fn` type.
- * @returns Mechanism of `populate_2_fn` type, which applies `fn` to two
- * flattened populations.
+ * @param p2 Selection to the next generation mechanism.
+ * @param fd Fitness function values database.
+ * @param s Surrogate model.
+ * @param fraction Fraction of offspring passed to `p2`.
+ * @param min_training_sz Minimum size of training set; offspring are not
+ * screened until the model is trained on that many genotypes.
+ * @returns Mechanism of `populate_2_fn` type.
  *
- * @note `adapter` can be useful when used with roulette wheel selection or
- * stochastic universal sampling as a method of selection to the next
- * generation.
+ * @throws std::invalid_argument If `fraction` is not in `(0, 1]`.
+ *
+ * @note Number of offspring passed to `p2` is rounded up, so at least one
+ * child survives screening of non-empty offspring; `p2` has to accept
+ * reduced offspring (e.g. `adapter` of selection of parents and offspring).
  *
  * Example:
- * @include selection.cc
+ * @include knn_surrogate.cc
  *
  * Result (might be different due to randomness):
- * @verbinclude selection.out
+ * @verbinclude knn_surrogate.out
  */
 template<typename G>
 requires chromosome<G> populate_2_fn<G>
-adapter(const populate_1_fn<G>& fn)
+surrogate_screening(const populate_2_fn<G>& p2,
+                    const fitness_db<G>& fd,
+                    const knn_surrogate<G>& s,
+                    probability fraction,
+                    std::size_t min_training_sz = 1)
 {
+  if (!(fraction > 0 && fraction <= 1)) {
+    throw std::invalid_argument{ "surrogate screening: bad fraction" };
+  }
   return [=](std::size_t sz, const population<G>& p0, const population<G>& p1) {
-    population<G> p{ p0 };
-    p.insert(p.end(), p1.begin(), p1.end());
-    return fn(sz, p);
+    s.update(fd);
+    if (s.size() < std::max<std::size_t>(min_training_sz, 1)) {
+      return p2(sz, p0, p1);
+    }
+    const fitnesses fs{ s(p1) };
+    std::vector<std::size_t> idx(p1.size());
+    std::iota(std::begin(idx), std::end(idx), 0);
+    const auto n = std::min(
+      p1.size(), static_cast<std::size_t>(std::ceil(fraction * p1.size())));
+    std::partial_sort(std::begin(idx),
+                      std::begin(idx) + n,
+                      std::end(idx),
+                      [&](std::size_t i, std::size_t j) { return fs[i] > fs[j]; });
+    idx.resize(n);
+    std::ranges::sort(idx);
+    population<G> q{};
+    std::ranges::transform(
+      idx, std::back_inserter(q), [&](std::size_t i) { return p1[i]; });
+    QUILE_LOG("Surrogate screening: " << q.size() << " of " << p1.size()
+                                      << " offspring passed, mean absolute "
+                                         "error "
+                                      << s.mean_absolute_error());
+    return p2(sz, p0, q);
   };
 }
 
+////////////////////////
+// Adaptive variation //
+////////////////////////
+
+namespace detail {
+
 /**
- * `random_population` returns random population of size `lambda`, where each
- * member genotype satisfies predicate `C`.
+ * `detail::adaptive_pursuit` implements adaptive pursuit of operator
+ * probabilities (D. Thierens, 2005) shared by all copies of adaptive operator.
  *
- * @tparam C Proper genotype predicate.
  * @tparam G Some `genotype` specialization.
- * @param lambda Size of returned population.
- * @returns Random population.
- *
- * Example:
- * @include random_population.cc
  *
- * Result (might be different due to randomness):
- * @verbinclude random_population.out
+ * @note Variation only records applied operators; offspring are assessed later
+ * with fitness values of regular evaluation (cf. `adaptive_assessment`).
  */
-template<auto C, typename G>
-requires genotype_constraints<decltype(C), G> && chromosome<G> population<G>
-random_population(std::size_t lambda)
+template<typename G>
+requires chromosome<G>
+class adaptive_pursuit
 {
-  population<G> res{};
-  auto g = G{};
-  for (std::size_t i = 0; i < lambda; ++i) {
-    while (!C(g.random_reset()))
-      ;
-    res.push_back(g);
+public:
+  adaptive_pursuit(std::size_t k,
+                   std::size_t window,
+                   probability p_min,
+                   double alpha,
+                   double beta)
+    : p_(k, 1. / k)
+    , q_(k, 1.)
+    , window_{ window }
+    , p_min_{ p_min }
+    , alpha_{ alpha }
+    , beta_{ beta }
+  {
+    if (k == 0 || window == 0 || p_min < 0. || k * p_min > 1.) {
+      throw std::invalid_argument{ "adaptive pursuit: bad parameters" };
+    }
+    update_cdf();
   }
-  return res;
-}
+
+  adaptive_pursuit(const adaptive_pursuit&) = delete;
+  adaptive_pursuit& operator=(const adaptive_pursuit&) = delete;
+
+  // Draws index of operator to apply from distribution rebuilt only by
+  // assessment.
+  std::size_t choose() const
+  {
+    const std::shared_lock<std::shared_mutex> sl{ pm_ };
+    const double u{ random_U(0., cdf_.back()) };
+    return std::min<std::size_t>(std::ranges::upper_bound(cdf_, u) -
+                                   std::begin(cdf_),
+                                 cdf_.size() - 1);
+  }
+
+  // Records that operator `i` produced `children` from `parents` in buffer of
+  // current thread, which keeps the last `window_` records. Within
+  // `variation` parents of the whole variation are recorded instead, since
+  // intermediate genotypes are not evaluated.
+  void record(std::size_t i,
+              population<G> parents,
+              const population<G>& children)
+  {
+    if (const auto [g0, g1] = varied_parents<G>(); g0) {
+      parents = population<G>{ *g0, *g1 };
+    }
+    const std::size_t n{ sequence_.fetch_add(children.size(),
+                                             std::memory_order_relaxed) };
+    for (bool renew = false;; renew = true) {
+      const auto b = local_buffer(renew);
+      const std::lock_guard<std::mutex> lg{ b->m };
+      // Buffer merged by assessment in the meantime.
+      if (b->merged) {
+        continue;
+      }
+      for (std::size_t j = 0; j < children.size(); ++j) {
+        entry e{ n + j, i, parents, children[j] };
+        if (b->entries.size() < window_) {
+          b->entries.push_back(std::move(e));
+        } else {
+          b->entries[b->next] = std::move(e);
+        }
+        b->next = (b->next + 1) % window_;
+      }
+      return;
+    }
+  }
+
+  // Merges buffers of all threads, keeping the last `window_` records. Child
+  // is successful if it is better than the best of its parents. Records with
+  // genotypes absent in `p` (e.g. recombination child changed later by
+  // mutation) are skipped.
+  void assess(const population<G>& p, const fitnesses& fs)
+  {
+    std::vector<entry> es{};
+    {
+      const std::lock_guard<std::mutex> lg0{ m_ };
+      for (const auto& b : buffers_) {
+        const std::lock_guard<std::mutex> lg1{ b->m };
+        b->merged = true;
+        std::ranges::move(b->entries, std::back_inserter(es));
+      }
+      buffers_.clear();
+    }
+    std::ranges::sort(es, {}, &entry::n);
+    if (es.size() > window_) {
+      es.erase(std::begin(es), std::end(es) - window_);
+    }
+    std::unordered_map<G, fitness> values{};
+    for (std::size_t i = 0; i < p.size(); ++i) {
+      values.emplace(p[i], fs[i]);
+    }
+    std::vector<std::size_t> uses(p_.size());
+    std::vector<std::size_t> successes(p_.size());
+    for (const auto& [n, i, ps, c] : es) {
+      const auto it = values.find(c);
+      if (it == values.end() || std::ranges::any_of(ps, [&](const G& g) {
+            return !values.contains(g);
+          })) {
+        continue;
+      }
+      fitness fp = values[ps[0]];
+      for (const auto& g : ps) {
+        fp = std::max(fp, values[g]);
+      }
+      ++uses[i];
+      successes[i] += it->second > fp;
+    }
+    const std::unique_lock<std::shared_mutex> ul{ pm_ };
+    for (std::size_t i = 0; i < p_.size(); ++i) {
+      if (uses[i]) {
+        q_[i] += alpha_ * (double(successes[i]) / uses[i] - q_[i]);
+      }
+    }
+    // Without any success (e.g. converged population) there is nothing to
+    // pursue.
+    if (std::ranges::none_of(successes, [](std::size_t x) { return x > 0; })) {
+      return;
+    }
+    const std::size_t best =
+      std::max_element(q_.begin(), q_.end()) - q_.begin();
+    const probability p_max = 1. - (p_.size() - 1) * p_min_;
+    for (std::size_t i = 0; i < p_.size(); ++i) {
+      p_[i] += beta_ * ((i == best ? p_max : p_min_) - p_[i]);
+    }
+    update_cdf();
+  }
+
+  std::vector<probability> probabilities() const
+  {
+    const std::shared_lock<std::shared_mutex> sl{ pm_ };
+    return p_;
+  }
+
+private:
+  // Record: sequence number, operator, parents and child.
+  struct entry
+  {
+    std::size_t n;
+    std::size_t i;
+    population<G> parents;
+    G child;
+  };
+
+  // Records of one thread (ring buffer) since the previous assessment.
+  struct buffer
+  {
+    std::mutex m{};
+    std::vector<entry> entries{};
+    std::size_t next{ 0 };
+    bool merged{ false };
+  };
+
+  // Buffer of current thread, registered on the first use or if `renew` is
+  // set (i.e. after assessment merged the previous one).
+  std::shared_ptr<buffer> local_buffer(bool renew)
+  {
+    static thread_local std::unordered_map<std::uint64_t,
+                                           std::weak_ptr<buffer>>
+      buffers{};
+    auto b = buffers[id_].lock();
+    if (b == nullptr || renew) {
+      std::erase_if(buffers, [](const auto& x) { return x.second.expired(); });
+      b = std::make_shared<buffer>();
+      {
+        const std::lock_guard<std::mutex> lg{ m_ };
+        buffers_.push_back(b);
+      }
+      buffers[id_] = b;
+    }
+    return b;
+  }
+
+  // Requires `pm_` to be locked exclusively.
+  void update_cdf()
+  {
+    cdf_.resize(p_.size());
+    std::partial_sum(std::begin(p_), std::end(p_), std::begin(cdf_));
+  }
+
+  static std::uint64_t unique_id()
+  {
+    static std::atomic<std::uint64_t> n{ 0 };
+    return n++;
+  }
+
+private:
+  const std::uint64_t id_{ unique_id() };
+  mutable std::shared_mutex pm_{};
+  std::vector<probability> p_;
+  std::vector<double> q_;
+  std::vector<double> cdf_{};
+  std::mutex m_{};
+  std::vector<std::shared_ptr<buffer>> buffers_{};
+  std::atomic<std::size_t> sequence_{ 0 };
+  std::size_t window_;
+  probability p_min_;
+  double alpha_;
+  double beta_;
+};
+
+} // namespace detail
 
 /**
- * `roulette_wheel_selection` is roulette wheel selection (a.k.a. roulette wheel
- * \em algorithm, RWA).
+ * `adaptive_mutation` is mutation, which applies one of mutations chosen
+ * randomly with probabilities adapted online according to observed offspring
+ * success (adaptive pursuit). Offspring is successful if it is better than its
+ * parents (within `variation` parents of recombination preceding mutation).
  *
  * @tparam G Some `genotype` specialization.
+ *
+ * @note Mutation `unary_identity<G>` can be one of alternatives, which makes
+ * mutation rate itself adaptive.
+ *
+ * @note Offspring is assessed after its regular evaluation, so selection to the
+ * next generation has to be extended with `adaptive_assessment`.
+ *
+ * Example:
+ * @include adaptive_variation.cc
+ *
+ * Result (might be different due to randomness):
+ * @verbinclude adaptive_variation.out
  */
 template<typename G>
 requires chromosome<G>
-class roulette_wheel_selection
+class adaptive_mutation
 {
 public:
   /**
-   * `roulette_wheel_selection::roulette_wheel_selection` constructor creates
-   * RWA with selection probability function `spf`.
+   * `adaptive_mutation::adaptive_mutation` constructor.
    *
-   * @param spf Selection probability function.
+   * @param ms Alternative mutations.
+   * @param window Number of the most recent offspring recorded between
+   * assessments, which are assessed.
+   * @param p_min Minimal probability of each alternative.
+   * @param alpha Adaptation rate of success rate estimates.
+   * @param beta Adaptation rate of probabilities.
+   *
+   * @throws std::invalid_argument Exception is raised if `ms` is empty,
+   * `window` is equal to zero or `p_min` is too big.
    */
-  explicit roulette_wheel_selection(const selection_probabilities_fn<G>& spf)
-    : spf_{ spf }
+  explicit adaptive_mutation(const std::vector<mutation_fn<G>>& ms,
+                             std::size_t window = 1000,
+                             probability p_min = .05,
+                             double alpha = .3,
+                             double beta = .3)
+    : ms_{ ms }
+    , ap_{ std::make_shared<detail::adaptive_pursuit<G>>(
+        ms.size(), window, p_min, alpha, beta) }
   {
   }
 
   /**
-   * `roulette_wheel_selection::operator()` draws `lambda` genotypes from
-   * population `p` according to the RWA.
+   * `adaptive_mutation::operator()` mutates genotype `g`.
    *
-   * @param lambda Size of the returned population.
-   * @param p Source population.
-   * @returns Population consisting of genotypes drawn from `p`.
+   * @param g Genotype.
+   * @returns Population containing mutated genotype.
    */
-  population<G> operator()(std::size_t lambda, const population<G>& p) const
+  population<G> operator()(const G& g) const
   {
-    QUILE_LOG("Roulette wheel selection");
-    const auto f = [&, c = cumulative_probabilities(spf_, p)]() -> G {
-      return p.at(std::distance(
-        c.begin(),
-        std::lower_bound(c.begin(), c.end(), random_U<double>(0., 1.))));
-    };
-    return detail::generate<G>(lambda, f);
+    const std::size_t i = ap_->choose();
+    population<G> res{ ms_[i](g) };
+    ap_->record(i, population<G>{ g }, res);
+    return res;
+  }
+
+  /**
+   * `adaptive_mutation::assess` updates probabilities of alternative mutations
+   * according to success of offspring recorded since previous assessment.
+   *
+   * @param p Evaluated genotypes (parents and offspring).
+   * @param fs Fitness function values of genotypes from `p`.
+   */
+  void assess(const population<G>& p, const fitnesses& fs) const
+  {
+    ap_->assess(p, fs);
+  }
+
+  /**
+   * `adaptive_mutation::probabilities` returns current probabilities of
+   * alternative mutations.
+   *
+   * @returns Probabilities in order of mutations passed to constructor.
+   */
+  std::vector<probability> probabilities() const
+  {
+    return ap_->probabilities();
   }
 
 private:
-  const selection_probabilities_fn<G> spf_;
+  std::vector<mutation_fn<G>> ms_;
+  std::shared_ptr<detail::adaptive_pursuit<G>> ap_;
 };
 
 /**
- * `stochastic_universal_sampling` is stochastic universal sampling (SUS).
+ * `adaptive_recombination` is recombination, which applies one of
+ * recombinations chosen randomly with probabilities adapted online according
+ * to observed offspring success (adaptive pursuit). Child is successful if it
+ * is better than the better parent.
  *
  * @tparam G Some `genotype` specialization.
  *
+ * @note Offspring is assessed after its regular evaluation, so selection to the
+ * next generation has to be extended with `adaptive_assessment`. Children
+ * changed afterwards by mutation are not assessed.
+ *
  * Example:
- * @include selection.cc
+ * @include adaptive_variation.cc
  *
  * Result (might be different due to randomness):
- * @verbinclude selection.out
+ * @verbinclude adaptive_variation.out
  */
 template<typename G>
 requires chromosome<G>
-class stochastic_universal_sampling
+class adaptive_recombination
 {
 public:
   /**
-   * `stochastic_universal_sampling::stochastic_universal_sampling` constructor
-   * creates SUS with selection probability function `spf`.
-   *
-   * @param spf Selection probability function.
+   * `adaptive_recombination::adaptive_recombination` constructor.
    *
-   * Example:
-   * @include selection.cc
+   * @param rs Alternative recombinations.
+   * @param window Number of the most recent offspring recorded between
+   * assessments, which are assessed.
+   * @param p_min Minimal probability of each alternative.
+   * @param alpha Adaptation rate of success rate estimates.
+   * @param beta Adaptation rate of probabilities.
    *
-   * Result (might be different due to randomness):
-   * @verbinclude selection.out
+   * @throws std::invalid_argument Exception is raised if `rs` is empty,
+   * `window` is equal to zero or `p_min` is too big.
    */
-  explicit stochastic_universal_sampling(
-    const selection_probabilities_fn<G>& spf)
-    : spf_{ spf }
+  explicit adaptive_recombination(const std::vector<recombination_fn<G>>& rs,
+                                  std::size_t window = 1000,
+                                  probability p_min = .05,
+                                  double alpha = .3,
+                                  double beta = .3)
+    : rs_{ rs }
+    , ap_{ std::make_shared<detail::adaptive_pursuit<G>>(
+        rs.size(), window, p_min, alpha, beta) }
   {
   }
 
   /**
-   * `stochastic_universal_sampling::operator()` draws `lambda` genotypes from
-   * population `p` according to the SUS.
-   *
-   * @param lambda Size of the returned population.
-   * @param p Source population.
-   * @returns Population consisting of genotypes drawn from `p`.
-   *
-   * Example:
-   * @include selection.cc
+   * `adaptive_recombination::operator()` recombines genotypes `g0` and `g1`.
    *
-   * Result (might be different due to randomness):
-   * @verbinclude selection.out
+   * @param g0 First parent.
+   * @param g1 Second parent.
+   * @returns Population containing offspring.
    */
-  population<G> operator()(std::size_t lambda, const population<G>& p) const
+  population<G> operator()(const G& g0, const G& g1) const
   {
-    QUILE_LOG("Stochastic Universal Sampling");
-    const auto a = cumulative_probabilities(spf_, p);
-    auto r = random_U<double>(0., 1. / lambda);
-
-    population<G> res{};
-    for (std::size_t i = 0, j = 0; j < lambda; ++i) {
-      for (; r <= a.at(i) && j < lambda; r += 1. / lambda, ++j) {
-        res.push_back(p.at(i));
-      }
-    }
-    std::shuffle(res.begin(), res.end(), random_engine());
+    const std::size_t i = ap_->choose();
+    population<G> res{ rs_[i](g0, g1) };
+    ap_->record(i, population<G>{ g0, g1 }, res);
     return res;
   }
 
+  /**
+   * `adaptive_recombination::assess` updates probabilities of alternative
+   * recombinations according to success of offspring recorded since previous
+   * assessment.
+   *
+   * @param p Evaluated genotypes (parents and offspring).
+   * @param fs Fitness function values of genotypes from `p`.
+   */
+  void assess(const population<G>& p, const fitnesses& fs) const
+  {
+    ap_->assess(p, fs);
+  }
+
+  /**
+   * `adaptive_recombination::probabilities` returns current probabilities of
+   * alternative recombinations.
+   *
+   * @returns Probabilities in order of recombinations passed to constructor.
+   */
+  std::vector<probability> probabilities() const
+  {
+    return ap_->probabilities();
+  }
+
 private:
-  const selection_probabilities_fn<G> spf_;
+  std::vector<recombination_fn<G>> rs_;
+  std::shared_ptr<detail::adaptive_pursuit<G>> ap_;
 };
 
 /**
- * `generational_survivor_selection` is generational survivor selection
- * mechanism.
+ * `adaptive_assessment` extends selection to the next generation mechanism
+ * `p2` with assessment of offspring produced by adaptive operators `as` (cf.
+ * `adaptive_mutation`, `adaptive_recombination`). After selection, fitness
+ * function values of parents generation and of offspring passed to `p2` are
+ * taken from `fd` and passed to operators.
  *
  * @tparam G Some `genotype` specialization.
- * @param sz Generation / offspring size.
- * @param generation Current generation.
- * @param offspring Offspring.
- * @returns Offspring.
+ * @param p2 Selection to the next generation mechanism.
+ * @param fd Fitness function values database.
+ * @param as Adaptive operators.
+ * @returns Mechanism of `populate_2_fn` type.
  *
- * @throws std::invalid_argument Exception is raised if `generation` size or
- * `offspring` size is different from `sz`.
+ * @note Fitness function values are requested after `p2`, so for selections
+ * evaluating all candidates they come from database. Offspring rejected
+ * before `p2` (e.g. by `surrogate_screening` wrapping the result) is neither
+ * calculated nor assessed.
+ *
+ * Example:
+ * @include adaptive_variation.cc
+ *
+ * Result (might be different due to randomness):
+ * @verbinclude adaptive_variation.out
  */
-template<typename G>
-requires chromosome<G> population<G>
-generational_survivor_selection(std::size_t sz,
-                                const population<G>& generation,
-                                const population<G>& offspring)
+template<typename G, typename... A>
+requires chromosome<G> populate_2_fn<G>
+adaptive_assessment(const populate_2_fn<G>& p2,
+                    const fitness_db<G>& fd,
+                    const A&... as)
 {
-  if (generation.size() != sz || offspring.size() != sz) {
-    throw std::invalid_argument{ "bad size" };
-  }
-  return offspring;
+  return [=](std::size_t sz, const population<G>& p0, const population<G>& p1) {
+    const population<G> res{ p2(sz, p0, p1) };
+    population<G> p{ p0 };
+    p.insert(p.end(), p1.begin(), p1.end());
+    const fitnesses fs{ fd(p) };
+    (as.assess(p, fs), ...);
+    return res;
+  };
 }
 
-///////////////////////////
-// Termination condition //
-///////////////////////////
+/////////////////////////////
+// Selection probabilities //
+/////////////////////////////
 
 /**
- * `max` returns maximum fitness function value from `fs`.
+ * `selection_probabilities` is a sequential container intended for keeping
+ * selection probabilities values.
  *
- * @param fs Fitness function values container.
- * @returns Maximum value.
+ * Example:
+ * @include spf.cc
  *
- * @throws std::runtime_error Exception is raised if all `fs` elements are equal
- * to `incalculable`.
+ * Result (might be different due to randomness):
+ * @verbinclude spf.out
  */
-inline fitness
-max(const fitnesses& fs)
-{
-  const fitnesses calc{ select_calculable(fs, true) };
-  return *std::ranges::max_element(calc);
-}
+using selection_probabilities = std::vector<probability>;
 
 /**
- * `max` returns maximum fitness function value for population `p` and database
- * intermediary object `ff`.
+ * `selection_probabilities_fn` is a callable object which can be invoked on
+ * population and returns corresponding selection probabilities for each
+ * genotype from population.
  *
- * @tparam G Some `genotype` specialization.
- * @param p Population.
- * @param ff Database intermediary object.
- * @returns Maximum value.
+ * Example:
+ * @include spf.cc
  *
- * @throws std::runtime_error Exception is raised if fitness function evaluates
- * to `incalculable` for all genotypes from `p`.
+ * Result (might be different due to randomness):
+ * @verbinclude spf.out
  */
 template<typename G>
-requires chromosome<G> fitness
-max(const population<G>& p, const fitness_db<G>& ff)
-{
-  return max(ff(p));
-}
+requires chromosome<G>
+using selection_probabilities_fn =
+  std::function<selection_probabilities(const population<G>&)>;
 
 /**
- * `max` returns maximum fitness function values for each generation from `gs`
- * and database intermediary object `ff`.
+ * `cumulative_probabilities` serves for calculation of cumulative selection
+ * probabilities, which can be used later in roulette wheel selection or
+ * stochastic universal sampling.
  *
  * @tparam G Some `genotype` specialization.
- * @param gs Sequence of generations.
- * @param ff Database intermediary object.
- * @returns Maximum values corresponding to each generation.
- *
- * @throws std::runtime_error Exception is raised if fitness function evaluates
- * to `incalculable` for all genotypes from at least one generation.
- */
-template<typename G>
-requires chromosome<G> fitnesses
-max(const generations<G>& gs, const fitness_db<G>& ff)
-{
-  fitnesses res{};
-  std::ranges::transform(gs,
-                         std::back_inserter(res),
-                         [&ff](const population<G>& p) { return max(p, ff); });
-  return res;
-}
-
-/**
- * `min` returns minimum fitness function value from `fs`.
+ * @param spf Selection probabilities function.
+ * @param p Population.
+ * @returns Cumulative selection probabilities.
  *
- * @param fs Fitness function values container.
- * @returns Minimum value.
+ * @note \em Cumulative selection probability for index `i` means sum of
+ * selection probabilities from index `0` up to `i`. Cumulative selection
+ * probability for last genotype in population is by definition equal to `1`.
  *
- * @throws std::runtime_error Exception is raised if all `fs` elements are equal
- * to `incalculable`.
- */
-inline fitness
-min(const fitnesses& fs)
-{
-  const fitnesses calc{ select_calculable(fs, true) };
-  return *std::ranges::min_element(calc);
-}
-
-/**
- * `min` returns minimum fitness function value for population `p` and database
- * intermediary object `ff`.
+ * @note It is guaranteed that last cumulative probability in returned
+ * container is equal to `1` without any numerical error.
  *
- * @tparam G Some `genotype` specialization.
- * @param p Population.
- * @param ff Database intermediary object.
- * @returns Minimum value.
+ * Example:
+ * @include spf.cc
  *
- * @throws std::runtime_error Exception is raised if fitness function evaluates
- * to `incalculable` for all genotypes from `p`.
+ * Result (might be different due to randomness):
+ * @verbinclude spf.out
  */
 template<typename G>
-requires chromosome<G> fitness
-min(const population<G>& p, const fitness_db<G>& ff)
+requires chromosome<G> selection_probabilities
+cumulative_probabilities(const selection_probabilities_fn<G>& spf,
+                         const population<G>& p)
 {
-  return min(ff(p));
+  auto res = spf(p);
+  std::partial_sum(res.begin(), res.end(), res.begin());
+  // Last element should be exactly equal to 1. and another part of algorithm
+  // might require this exact identity. Unfortunately, numerical calculations
+  // might not be so precise. Let's check if last element is calculated with
+  // 1% precision (basic requirement):
+  assert(res.back() > .99 && res.back() < 1.01);
+  // Then, let's correct the value:
+  res.back() = 1.;
+  return res;
 }
 
 /**
- * `min` returns minimum fitness function values for each generation from `gs`
- * and database intermediary object `ff`.
+ * `select_different_than` returns copy of container `c` with deleted elements
+ * equal to `t`.
  *
- * @tparam G Some `genotype` specialization.
- * @param gs Sequence of generations.
- * @param ff Database intermediary object.
- * @returns Minimum values corresponding to each generation.
+ * @tparam C Container type.
+ * @tparam T Type convertible to C container element type.
+ * @param c Container.
+ * @param t Element to be dropped in returned container.
+ * @param require_nonempty_result Flag for possible exception.
+ * @returns Container with values different than `t`.
  *
- * @throws std::runtime_error Exception is raised if fitness function evaluates
- * to `incalculable` for all genotypes from at least one generation.
+ * @throws std::runtime_error Exception is raised if `require_nonempty_result`
+ * is `true` and returned container is empty.
  */
-template<typename G>
-requires chromosome<G> fitnesses
-min(const generations<G>& gs, const fitness_db<G>& ff)
+template<typename C, typename T>
+C
+select_different_than(const C& c, T t, bool require_nonempty_result)
 {
-  fitnesses res{};
-  std::ranges::transform(gs,
-                         std::back_inserter(res),
-                         [&ff](const population<G>& p) { return min(p, ff); });
+  C res{};
+  std::ranges::copy_if(
+    c, std::back_inserter(res), [=](auto x) { return x != t; });
+  if (require_nonempty_result && res.size() == 0) {
+    throw std::runtime_error{ "empty result" };
+  }
   return res;
 }
 
 /**
- * `max_iterations_termination` returns condition, which terminates algorithm
- * after performing `max` loop iterations.
+ * `select_calculable` returns container with fitness function values equal to
+ * `fs`, but with `incalculable` entries skipped.
  *
- * @tparam G Some `genotype` specialization.
- * @param max Number of genetic algorithm loop iteration to perform (number of
- * generations).
- * @returns Predicate terminating genetic algorithm after `max` iterations.
+ * @param fs Fitness function values container.
+ * @param require_nonempty_result Flag for possible exception.
+ * @returns Container with values different than `incalculable`.
+ *
+ * @throws std::runtime_error Exception is raised if `require_nonempty_result`
+ * is `true` and returned container is empty.
  */
-template<typename G>
-termination_condition_fn<G>
-max_iterations_termination(std::size_t max)
+inline fitnesses
+select_calculable(const fitnesses& fs, bool require_nonempty_result = false)
 {
-  return [=](std::size_t i, const generations<G>&) { return i == max; };
+  return select_different_than(fs, incalculable, require_nonempty_result);
 }
 
 /**
- * `max_fitness_improvement_termination` returns condition, which terminates
- * algorithm after reaching fitness function \em plateau. The algorithm is
- * terminated if after `n` last generations fitness function maximum has not
- * improved \em relatively more than `frac` with respect to the whole
- * evolutionary process.
+ * `fitness_proportional_selection` is fitness proportional selection (a.k.a.
+ * fitness \em proportionate selection) with windowing procedure (FPS).
  *
  * @tparam G Some `genotype` specialization.
- * @param ff Database intermediary object.
- * @param n Number of \em last generations.
- * @param frac \em Plateau \em flatness.
- * @returns Predicate terminating genetic algorithm after reaching fitness
- * function \em plateau.
  *
- * @throws std::runtime_error Exception is raised if fitness function evaluates
- * to `incalculable` for all genotypes from at least one generation.
- * @note This condition is not intended for use with `evolution` argument
- * `max_history` different than `0`.
+ * @note This implementation has workarounds for population of equally fit
+ * genotypes and populations containing genotypes which fitnesses cannot be
+ * calculated. Please note that there should be at least one genotype, which
+ * fitness can be calculated.
  *
  * Example:
- * @include self_adaptive.cc
+ * @include spf.cc
  *
  * Result (might be different due to randomness):
- * @verbinclude self_adaptive.out
- *
- * @note Evolution result is saved in separate file (not included).
+ * @verbinclude spf.out
  */
 template<typename G>
-termination_condition_fn<G>
-max_fitness_improvement_termination(const fitness_db<G>& ff,
-                                    std::size_t n,
-                                    double frac)
+class fitness_proportional_selection
 {
-  return [=]([[maybe_unused]] std::size_t i, const generations<G>& gs) {
-    assert(i == gs.size());
-    if (gs.size() <= n) {
-      return false;
-    } else {
-      const fitnesses fs{ max(gs, ff) };
-      const fitness min_last_n = *std::min_element(fs.end() - n, fs.end());
-      const double x = (max(fs) - min_last_n) / (max(fs) - min(fs));
-      return x <= frac;
-    }
-  };
-}
+public:
+  /**
+   * `fitness_proportional_selection::fitness_proportional_selection`
+   * constructor creates FPS mechanism for database represented by intermediary
+   * object `ff`.
+   *
+   * @param ff Fitness database intermediary object.
+   *
+   * Example:
+   * @include spf.cc
+   *
+   * Result (might be different due to randomness):
+   * @verbinclude spf.out
+   */
+  explicit fitness_proportional_selection(const fitness_db<G>& ff)
+    : ff_{ ff }
+  {
+  }
+
+  /**
+   * `fitness_proportional_selection::operator()` returns selection
+   * probabilities for population `p`.
+   *
+   * @param p Population.
+   * @returns FPS selection probabilities for population `p`.
+   *
+   * @throws std::runtime_error Exception is raised if fitness function
+   * evaluates to `incalculable` for all genotypes from `p`.
+   *
+   * Example:
+   * @include spf.cc
+   *
+   * Result (might be different due to randomness):
+   * @verbinclude spf.out
+   */
+  selection_probabilities operator()(const population<G>& p) const
+  {
+    const fitnesses fs{ ff_(p) };
+    const auto cal = select_calculable(fs, true);
+    const fitness min = *std::ranges::min_element(cal);
+    const auto n = cal.size(); // Value of n is guaranteed to be greater than 0.
+    const fitness delta = 1. / n;
+    const fitness sum =
+      std::accumulate(std::begin(cal), std::end(cal), fitness{ 0. }) - n * min +
+      1;
+    selection_probabilities res{};
+    std::ranges::transform(fs, std::back_inserter(res), [=](fitness f) {
+      return f == incalculable ? .0 : (f - min + delta) / sum;
+    });
+    return res;
+  }
+
+private:
+  const fitness_db<G> ff_;
+};
+
+namespace detail {
 
 /**
- * `max_fitness_improvement_termination_2` returns condition, which terminates
- * algorithm after reaching fitness function \em plateau. The algorithm is
- * terminated if after `n` last generations fitness function maximum has not
- * improved \em absolutely more than `delta` with respect to the whole
- * evolutionary process.
- *
- * @tparam G Some `genotype` specialization.
- * @param ff Database intermediary object.
- * @param n Number of \em last generations.
- * @param delta \em Plateau \em flatness.
- * @returns Predicate terminating genetic algorithm after reaching fitness
- * function \em plateau.
+ * `detail::advance_cpy` wraps `std::advance` and returns iterator.
  *
- * @throws std::runtime_error Exception is raised if fitness function evaluates
- * to `incalculable` for all genotypes from at least one generation.
- * @note This condition is not intended for use with `evolution` argument
- * `max_history` different than `0`.
+ * @tparam It Iterator type.
+ * @param it Iterator.
+ * @param n Distance to advance.
+ * @returns Advanced iterator.
  */
-template<typename G>
-termination_condition_fn<G>
-max_fitness_improvement_termination_2(const fitness_db<G>& ff,
-                                      std::size_t n,
-                                      fitness delta)
+template<typename It>
+It
+advance_cpy(It it, std::size_t n)
 {
-  return [=]([[maybe_unused]] std::size_t i, const generations<G>& gs) {
-    assert(i == gs.size() && delta >= .0);
-    if (gs.size() <= n) {
-      return false;
-    } else {
-      const fitnesses fs{ max(gs, ff) };
-      const fitness max_0 = *std::max_element(fs.begin(), fs.end() - n);
-      const fitness max_1 = *std::max_element(fs.end() - n, fs.end());
-      return max_1 <= max_0 + delta;
-    }
-  };
+  std::advance(it, n);
+  return it;
 }
 
 /**
- * `threshold_termination` returns condition, which terminates algorithm if at
- * least one genotype fulfills predicate `thr`.
+ * `detail::rank` returns ranking position of element in range after stable
+ * sort.
  *
- * @tparam G Some `genotype` specialization.
- * @tparam F Predicate type.
- * @param thr Predicate identifying searched genotype.
- * @returns Predicate terminating genetic algorithm after genotype satisfying
- * `thr` predicate is found.
+ * @tparam It Iterator type.
+ * @tparam Compare Type of comparison mechanism.
+ * @param first Range begin.
+ * @param last Range end.
+ * @param comp Comparison function object.
+ * @returns Sequence container with ranking positions.
  */
-template<typename G, typename F>
-requires chromosome<G> && std::predicate<F, G> termination_condition_fn<G>
-threshold_termination(const F& thr)
+template<typename It, typename Compare = std::less<>>
+std::vector<std::size_t>
+rank(It first, It last, Compare comp = {})
 {
-  return [=](std::size_t, const generations<G>& gs) {
-    return gs.empty() ? false : std::ranges::any_of(gs.back(), thr);
-  };
+  std::vector<std::size_t> v(std::distance(first, last), 0);
+  std::ranges::generate(v, [i = std::size_t{ 0 }]() mutable { return i++; });
+  std::ranges::stable_sort(v, [first, &comp](auto a, auto b) {
+    return comp(*advance_cpy(first, a), *advance_cpy(first, b));
+  });
+  std::vector<std::size_t> res(v.size(), 0);
+  for (std::size_t i = 0; auto x : v) {
+    res.at(x) = i++;
+  }
+  return res;
 }
 
 /**
- * `fitness_threshold_termination` returns condition, which terminates algorithm
- * if at least one genotype reaches `thr` fitness function value with absolute
- * precision `eps`.
+ * `detail::id` performs identity operation between types.
  *
- * @tparam G Some `genotype` specialization.
- * @param fd Database intermediary object.
- * @param thr Fitness function value to achieve.
- * @param eps Fitness function value absolute precision.
- * @returns Predicate terminating genetic algorithm after genotype reaching
- * fitness function value `thr` with absolute precision `eps` is found.
+ * @tparam T Destination type.
+ * @tparam U Source type.
+ * @param u Argument.
+ * @returns Argument after transformation to destination type.
  */
-template<typename G>
-termination_condition_fn<G>
-fitness_threshold_termination(const fitness_db<G>& fd, fitness thr, fitness eps)
+template<typename T, typename U>
+T
+id(U u)
 {
-  const auto f = [=](const G& g) { return std::fabs(fd(g) - thr) <= eps; };
-  return threshold_termination<G, decltype(f)>(f);
+  return u;
 }
 
-/////////////////////////////////////////////////
-// Concrete mutation & recombination operators //
-/////////////////////////////////////////////////
+} // namespace detail
 
 /**
- * `Gaussian_mutation` returns Gaussian mutation operator with standard
- * deviation `sigma` and gene mutation probability `p`.
+ * `linear_ranking_selection` creates linear pressure mechanism for ranking
+ * selection.
  *
- * @tparam G Some `genotype` specialization.
- * @param sigma Standard deviation.
- * @param p Gene mutation probability.
- * @returns Gaussian mutation operator.
+ * @param s So-called \em s parameter.
+ * @returns Linear pressure mechanism.
  *
  * Example:
- * @include Gaussian_mutation.cc
+ * @include spf.cc
  *
  * Result (might be different due to randomness):
- * @verbinclude Gaussian_mutation.out
- *
- * @note Evolution result is saved in separate file (not included).
+ * @verbinclude spf.out
  */
-template<typename G>
-requires floating_point_chromosome<G>
-auto
-Gaussian_mutation(typename G::gene_t sigma, probability p)
+inline auto
+linear_ranking_selection(double s)
 {
-  return [=](const G& g) -> population<G> {
-    G res{};
-    const auto c = G::constraints();
-    for (std::size_t i = 0; i < G::size(); ++i) {
-      if (success(p)) {
-        res.value(i, c[i].clamp(g.value(i) + sigma * random_N(0., 1.)));
-      }
-    }
-    return population<G>{ res };
+  return [s](std::size_t mu, std::size_t j) -> probability {
+    assert(mu > 0 && 1. < s && s <= 2. && j < mu);
+    const auto id = detail::id<probability, std::size_t>;
+    return mu == 1
+             ? 1.
+             : (2 - s) / id(mu) + 2 * id(j) * (s - 1) / (id(mu) * (id(mu) - 1));
   };
 }
 
 /**
- * `self_adaptive_mutation` returns self adaptive mutation operator with
- * parameters `a0` and `a1`.
- *
- * @tparam G Some `genotype` specialization.
- * @param a0 Self adaptive mutation parameter.
- * @param a1 Self adaptive mutation parameter.
- * @returns Self adaptive mutation operator.
- *
- * @note Due to documentation processing problem the above template declaration
- * is incorrect. Corrected declaration:
- * @code
- * template<typename G>
- * requires floating_point_chromosome<G> && (G::size() % 2 == 0)
- * auto self_adaptive_mutation(typename G::gene_t a0, typename G::gene_t a1)
- * @endcode
+ * `exponential_ranking_selection` is exponential pressure mechanism for ranking
+ * selection.
  *
  * Example:
- * @include self_adaptive.cc
+ * @include spf.cc
  *
  * Result (might be different due to randomness):
- * @verbinclude self_adaptive.out
- *
- * @note Evolution result is saved in separate file (not included).
+ * @verbinclude spf.out
  */
-template<typename G>
-requires floating_point_chromosome<G>
-  /**
-   * \cond
-   */
-  &&(G::size() % 2 == 0)
-  // This unfortunately cannot be processed properly by documentation system.
-  /**
-   * \endcond
-   */
-  auto self_adaptive_mutation(typename G::gene_t a0, typename G::gene_t a1)
+inline probability
+exponential_ranking_selection(std::size_t mu, std::size_t j)
 {
-  return [=, n = G::size() / 2, c = G::constraints()](const G& g) {
-    using type = typename G::gene_t;
-    const type p0 = random_N(0., 1.) * a0 / std::sqrt(2 * n);
-    const type t1 = a1 / std::sqrt(2 * std::sqrt(n));
-    G res{};
-    for (std::size_t i = 0; i < n; ++i) {
-      const type sigma =
-        c[i + n].clamp(g.value(i + n) * std::exp(p0 + t1 * random_N(0., 1.)));
-      res.value(i, c[i].clamp(g.value(i) + sigma * random_N(0., 1.)));
-      res.value(i + n, sigma);
-    }
-    return population<G>{ g };
-  };
+  assert(mu > 0 && j < mu);
+  const auto e = std::numbers::e_v<probability>;
+  const auto id = detail::id<probability, std::size_t>;
+  // Consider difference between -id(mu) and -mu for std::size_t mu.
+  return mu == 1 ? 1.
+                 : (1. - std::exp(-id(j))) * (1. - e) /
+                     (id(mu) * (1. - e) + e - std::exp(1 - id(mu)));
 }
 
 /**
- * `swap_mutation` is swap mutation.
+ * `ranking_selection` is ranking selection (RS) mechanism.
  *
- * @tparam G Some `genotype` specialization.
- * @param g Genotype.
- * @returns Population containing mutated genotype.
+ * @note This implementation has workarounds for populations containing
+ * genotypes which fitnesses cannot be calculated. Please note that there should
+ * be at least one genotype, which fitness can be calculated.
  *
  * Example:
- * @include variation.cc
+ * @include spf.cc
  *
  * Result (might be different due to randomness):
- * @verbinclude variation.out
+ * @verbinclude spf.out
  */
 template<typename G>
-requires uniform_chromosome<G> population<G>
-swap_mutation(const G& g)
+class ranking_selection
 {
-  const std::size_t n = G::size();
-  auto d = g.data();
-  std::swap(d[random_U<std::size_t>(0, n - 1)],
-            d[random_U<std::size_t>(0, n - 1)]);
-  return population<G>{ G{ d } };
+private:
+  using probability_fn = std::function<probability(std::size_t, std::size_t)>;
+
+public:
+  /**
+   * `ranking_selection::ranking_selection` constructor creates RS.
+   *
+   * @param ff Fitness function database intermediary object.
+   * @param pf Selection pressure mechanism (linear or exponential).
+   *
+   * Example:
+   * @include spf.cc
+   *
+   * Result (might be different due to randomness):
+   * @verbinclude spf.out
+   */
+  ranking_selection(const fitness_db<G>& ff, const probability_fn& pf)
+    : ff_{ ff }
+    , pf_{ pf }
+  {
+  }
+
+  /**
+   * `ranking_selection::operator()` returns selection probabilities for
+   * population `p`.
+   *
+   * @param p Population.
+   * @returns RS selection probabilities for population `p`.
+   *
+   * @throws std::runtime_error Exception is raised if fitness function
+   * evaluates to `incalculable` for all genotypes from `p`.
+   *
+   * Example:
+   * @include spf.cc
+   *
+   * Result (might be different due to randomness):
+   * @verbinclude spf.out
+   */
+  selection_probabilities operator()(const population<G>& p) const
+  {
+    const fitnesses fs{ ff_(p) };
+    auto r = detail::rank(
+      std::begin(p), std::end(p), [&](const auto& a, const auto& b) {
+        return ff_(a) < ff_(b);
+      });
+    const auto mu = select_calculable(fs, true).size();
+    const auto nq = p.size() - mu;
+    selection_probabilities res{};
+    std::ranges::transform(r, std::back_inserter(res), [=, this](auto j) {
+      return j < nq ? 0. : pf_(mu, j - nq);
+    });
+    return res;
+  }
+
+private:
+  const fitness_db<G> ff_;
+  const probability_fn pf_;
+};
+
+////////////////////////////
+// Generators & selectors //
+////////////////////////////
+
+namespace detail {
+
+/**
+ * `detail::generate` creates population of size `lambda` filled with result of
+ * function `f`.
+ *
+ * @tparam G Some `genotype` specialization.
+ * @param lambda Result population size.
+ * @param f Function returning genotype.
+ * @returns Population of size `lambda` where each member is result of `f`.
+ */
+template<typename G>
+requires chromosome<G> population<G>
+generate(std::size_t lambda, const std::function<G()>& f)
+{
+  population<G> res{};
+  std::generate_n(std::back_inserter(res), lambda, f);
+  return res;
 }
 
+} // namespace detail
+
 /**
- * `random_reset` returns random reset mutation with parameter `p`.
+ * `adapter` implements \em flatten function between `populate_2_fn` mechanism
+ * and `populate_1_fn` mechanism.
  *
  * @tparam G Some `genotype` specialization.
- * @param p Gene mutation probability.
- * @returns Random reset mutation operator.
+ * @param fn Mechanism of `populate_1_fn` type.
+ * @returns Mechanism of `populate_2_fn` type, which applies `fn` to two
+ * flattened populations.
+ *
+ * @note `adapter` can be useful when used with roulette wheel selection or
+ * stochastic universal sampling as a method of selection to the next
+ * generation.
+ *
+ * Example:
+ * @include selection.cc
+ *
+ * Result (might be different due to randomness):
+ * @verbinclude selection.out
  */
 template<typename G>
-requires floating_point_chromosome<G> || integer_chromosome<G> ||
-  binary_chromosome<G>
-auto
-random_reset(probability p)
+requires chromosome<G> populate_2_fn<G>
+adapter(const populate_1_fn<G>& fn)
 {
-  return [=](const G& g) -> population<G> {
-    G res{ g };
-    for (std::size_t i = 0; i < G::size(); ++i) {
-      if (success(p)) {
-        res.random_reset(i);
+  return [=](std::size_t sz, const population<G>& p0, const population<G>& p1) {
+    population<G> p{ p0 };
+    p.insert(p.end(), p1.begin(), p1.end());
+    return fn(sz, p);
+  };
+}
+
+/**
+ * `local_refinement` extends selection to the next generation mechanism `p2`
+ * with memetic local search stage: `k` best genotypes of selected population
+ * are improved by pattern (compass) search within the domain and replace
+ * their originals.
+ *
+ * @tparam G Some `genotype` specialization.
+ * @param p2 Selection to the next generation mechanism.
+ * @param fd Fitness function values database.
+ * @param k Number of refined genotypes (distinct ones). Default value is equal
+ * to 2.
+ * @param iterations Number of pattern search iterations. Default value is
+ * equal to 20.
+ * @param step Initial step as a fraction of width of each domain range.
+ * Default value is equal to 0.001.
+ * @returns Mechanism of `populate_2_fn` type.
+ *
+ * @note In each iteration all \f$2N\f$ trial points of all `k` genotypes are
+ * evaluated at once, i.e. concurrently, by `fd`; thereby evaluations are
+ * shared with evolution. Genotype moves to its best improving trial point,
+ * otherwise its step is halved. Each generation costs at most
+ * \f$2kN \cdot {\rm iterations}\f$ evaluations.
+ *
+ * Example:
+ * @include local_refinement.cc
+ *
+ * Result (might be different due to randomness):
+ * @verbinclude local_refinement.out
+ */
+template<typename G>
+requires floating_point_chromosome<G> populate_2_fn<G>
+local_refinement(const populate_2_fn<G>& p2,
+                 const fitness_db<G>& fd,
+                 std::size_t k = 2,
+                 std::size_t iterations = 20,
+                 typename G::gene_t step = .001)
+{
+  return [=](std::size_t sz, const population<G>& p0, const population<G>& p1) {
+    using T = typename G::gene_t;
+    population<G> res{ p2(sz, p0, p1) };
+    const fitnesses fs{ fd(res) };
+    std::vector<std::size_t> order(res.size());
+    std::iota(std::begin(order), std::end(order), 0);
+    std::ranges::stable_sort(
+      order, std::ranges::greater{}, [&](std::size_t i) { return fs[i]; });
+    // Copies of genotype are refined once.
+    std::vector<std::size_t> best{};
+    std::unordered_set<G> distinct{};
+    for (auto i : order) {
+      if (best.size() == k) {
+        break;
+      }
+      if (distinct.insert(res[i]).second) {
+        best.push_back(i);
+      }
+    }
+    const std::size_t r = best.size();
+    const auto& c = G::constraints();
+    std::vector<T> h(r, step);
+    for (std::size_t it = 0; it < iterations; ++it) {
+      population<G> trials{};
+      for (std::size_t j = 0; j < r; ++j) {
+        if (h[j] < step / 16) {
+          continue;
+        }
+        const G& g = res[best[j]];
+        for (std::size_t i = 0; i < G::size(); ++i) {
+          const T d = h[j] * (c[i].max() - c[i].min());
+          for (const T v : { c[i].clamp(g.value(i) - d),
+                             c[i].clamp(g.value(i) + d) }) {
+            G t{ g };
+            trials.push_back(t.value(i, v));
+          }
+        }
+      }
+      const fitnesses ft{ fd(trials) };
+      for (std::size_t j = 0, t = 0, n = 2 * G::size(); j < r; ++j) {
+        if (h[j] < step / 16) {
+          continue;
+        }
+        const auto first = std::begin(ft) + t;
+        const auto m = std::max_element(first, first + n);
+        if (*m > fd(res[best[j]])) {
+          res[best[j]] = trials[t + (m - first)];
+          h[j] *= 2;
+        } else {
+          h[j] /= 2;
+        }
+        t += n;
+      }
+      if (trials.empty()) {
+        break;
       }
     }
-    return population<G>{ res };
+    return res;
   };
 }
 
 /**
- * `bit_flipping` returns bit-flipping mutation with parameter `p`.
+ * `random_population` returns random population of size `lambda`, where each
+ * member genotype satisfies predicate `C`.
+ *
+ * @tparam C Proper genotype predicate.
+ * @tparam G Some `genotype` specialization.
+ * @param lambda Size of returned population.
+ * @returns Random population.
+ *
+ * Example:
+ * @include random_population.cc
+ *
+ * Result (might be different due to randomness):
+ * @verbinclude random_population.out
+ */
+template<auto C, typename G>
+requires genotype_constraints<decltype(C), G> && chromosome<G> population<G>
+random_population(std::size_t lambda)
+{
+  population<G> res{};
+  auto g = G{};
+  for (std::size_t i = 0; i < lambda; ++i) {
+    while (!C(g.random_reset()))
+      ;
+    res.push_back(g);
+  }
+  return res;
+}
+
+/**
+ * `sampler_fn` is constructive sampler, i.e. callable object creating random
+ * genotypes which satisfy (or are likely to satisfy) constraints of problem by
+ * construction, e.g. by growing connected cluster of atoms.
+ *
+ * Example:
+ * @include constrained_population.cc
+ *
+ * Result (might be different due to randomness):
+ * @verbinclude constrained_population.out
+ */
+template<typename G>
+requires chromosome<G>
+using sampler_fn = std::function<G()>;
+
+/**
+ * `repair_fn` is repair operator, i.e. callable object returning genotype
+ * similar to its argument which satisfies (or is likely to satisfy)
+ * constraints of problem.
+ *
+ * Example:
+ * @include constrained_population.cc
+ *
+ * Result (might be different due to randomness):
+ * @verbinclude constrained_population.out
+ */
+template<typename G>
+requires chromosome<G>
+using repair_fn = std::function<G(const G&)>;
+
+/**
+ * `constrained_population` creates populations of genotypes satisfying genotype
+ * constraints with use of constructive sampler and optional repair operator.
+ * Candidate created by sampler which violates constraints is repaired and
+ * rejected only if repaired genotype violates them too. For heavily
+ * constrained representations it replaces pure rejection sampling of
+ * `random_population`, which accepts candidates with probability decreasing
+ * exponentially with genotype length. Numbers of candidates, accepted and
+ * repaired genotypes are counted.
+ *
+ * @tparam G Some `genotype` specialization.
+ *
+ * @note Copies of object (e.g. in `populate_0_fn`) share the counters.
+ */
+template<typename G>
+requires chromosome<G>
+class constrained_population
+{
+public:
+  /**
+   * `constrained_population::constrained_population` constructor.
+   *
+   * @param gc Genotype constraints.
+   * @param s Constructive sampler.
+   * @param r Repair operator. Default empty value means no repair.
+   *
+   * Example:
+   * @include constrained_population.cc
+   *
+   * Result (might be different due to randomness):
+   * @verbinclude constrained_population.out
+   */
+  constrained_population(const genotype_constraints<G> auto& gc,
+                         const sampler_fn<G>& s,
+                         const repair_fn<G>& r = {})
+    : gc_{ gc }
+    , s_{ s }
+    , r_{ r }
+  {
+  }
+
+  /**
+   * `constrained_population::operator()` returns population of size `lambda`,
+   * where each genotype satisfies genotype constraints.
+   *
+   * @param lambda Size of returned population.
+   * @returns Population.
+   *
+   * Example:
+   * @include constrained_population.cc
+   *
+   * Result (might be different due to randomness):
+   * @verbinclude constrained_population.out
+   */
+  population<G> operator()(std::size_t lambda) const
+  {
+    population<G> res{};
+    while (res.size() < lambda) {
+      ++stats_->candidates;
+      G g{ s_() };
+      if (!gc_(g)) {
+        if (!r_ || !gc_(g = r_(g))) {
+          continue;
+        }
+        ++stats_->repaired;
+      }
+      ++stats_->accepted;
+      res.push_back(g);
+    }
+    QUILE_LOG("Constrained population: acceptance rate " << acceptance_rate());
+    return res;
+  }
+
+  /**
+   * `constrained_population::candidates` returns number of genotypes created
+   * by sampler so far.
+   *
+   * @returns Number of candidates.
+   */
+  std::size_t candidates() const { return stats_->candidates; }
+
+  /**
+   * `constrained_population::accepted` returns number of genotypes accepted so
+   * far (including repaired ones).
+   *
+   * @returns Number of accepted genotypes.
+   */
+  std::size_t accepted() const { return stats_->accepted; }
+
+  /**
+   * `constrained_population::repaired` returns number of genotypes accepted
+   * after repair so far.
+   *
+   * @returns Number of repaired genotypes.
+   */
+  std::size_t repaired() const { return stats_->repaired; }
+
+  /**
+   * `constrained_population::acceptance_rate` returns ratio of accepted
+   * genotypes to candidates.
+   *
+   * @returns Acceptance rate (zero if there are no candidates yet).
+   */
+  double acceptance_rate() const
+  {
+    const std::size_t c{ candidates() };
+    return c ? static_cast<double>(accepted()) / c : 0.;
+  }
+
+private:
+  struct statistics
+  {
+    std::atomic<std::size_t> candidates{ 0 };
+    std::atomic<std::size_t> accepted{ 0 };
+    std::atomic<std::size_t> repaired{ 0 };
+  };
+
+  std::function<bool(const G&)> gc_;
+  sampler_fn<G> s_;
+  repair_fn<G> r_;
+  std::shared_ptr<statistics> stats_{ std::make_shared<statistics>() };
+};
+
+/**
+ * `roulette_wheel_selection` is roulette wheel selection (a.k.a. roulette wheel
+ * \em algorithm, RWA).
+ *
+ * @tparam G Some `genotype` specialization.
+ */
+template<typename G>
+requires chromosome<G>
+class roulette_wheel_selection
+{
+public:
+  /**
+   * `roulette_wheel_selection::roulette_wheel_selection` constructor creates
+   * RWA with selection probability function `spf`.
+   *
+   * @param spf Selection probability function.
+   */
+  explicit roulette_wheel_selection(const selection_probabilities_fn<G>& spf)
+    : spf_{ spf }
+  {
+  }
+
+  /**
+   * `roulette_wheel_selection::operator()` draws `lambda` genotypes from
+   * population `p` according to the RWA.
+   *
+   * @param lambda Size of the returned population.
+   * @param p Source population.
+   * @returns Population consisting of genotypes drawn from `p`.
+   */
+  population<G> operator()(std::size_t lambda, const population<G>& p) const
+  {
+    QUILE_LOG("Roulette wheel selection");
+    const auto f = [&, c = cumulative_probabilities(spf_, p)]() -> G {
+      return p.at(std::distance(
+        c.begin(),
+        std::lower_bound(c.begin(), c.end(), random_U<double>(0., 1.))));
+    };
+    return detail::generate<G>(lambda, f);
+  }
+
+private:
+  const selection_probabilities_fn<G> spf_;
+};
+
+/**
+ * `stochastic_universal_sampling` is stochastic universal sampling (SUS).
+ *
+ * @tparam G Some `genotype` specialization.
+ *
+ * Example:
+ * @include selection.cc
+ *
+ * Result (might be different due to randomness):
+ * @verbinclude selection.out
+ */
+template<typename G>
+requires chromosome<G>
+class stochastic_universal_sampling
+{
+public:
+  /**
+   * `stochastic_universal_sampling::stochastic_universal_sampling` constructor
+   * creates SUS with selection probability function `spf`.
+   *
+   * @param spf Selection probability function.
+   *
+   * Example:
+   * @include selection.cc
+   *
+   * Result (might be different due to randomness):
+   * @verbinclude selection.out
+   */
+  explicit stochastic_universal_sampling(
+    const selection_probabilities_fn<G>& spf)
+    : spf_{ spf }
+  {
+  }
+
+  /**
+   * `stochastic_universal_sampling::operator()` draws `lambda` genotypes from
+   * population `p` according to the SUS.
+   *
+   * @param lambda Size of the returned population.
+   * @param p Source population.
+   * @returns Population consisting of genotypes drawn from `p`.
+   *
+   * Example:
+   * @include selection.cc
+   *
+   * Result (might be different due to randomness):
+   * @verbinclude selection.out
+   */
+  population<G> operator()(std::size_t lambda, const population<G>& p) const
+  {
+    QUILE_LOG("Stochastic Universal Sampling");
+    const auto a = cumulative_probabilities(spf_, p);
+    auto r = random_U<double>(0., 1. / lambda);
+
+    population<G> res{};
+    for (std::size_t i = 0, j = 0; j < lambda; ++i) {
+      for (; r <= a.at(i) && j < lambda; r += 1. / lambda, ++j) {
+        res.push_back(p.at(i));
+      }
+    }
+    std::shuffle(res.begin(), res.end(), random_engine());
+    return res;
+  }
+
+private:
+  const selection_probabilities_fn<G> spf_;
+};
+
+/**
+ * `generational_survivor_selection` is generational survivor selection
+ * mechanism.
+ *
+ * @tparam G Some `genotype` specialization.
+ * @param sz Generation / offspring size.
+ * @param generation Current generation.
+ * @param offspring Offspring.
+ * @returns Offspring.
+ *
+ * @throws std::invalid_argument Exception is raised if `generation` size or
+ * `offspring` size is different from `sz`.
+ */
+template<typename G>
+requires chromosome<G> population<G>
+generational_survivor_selection(std::size_t sz,
+                                const population<G>& generation,
+                                const population<G>& offspring)
+{
+  if (generation.size() != sz || offspring.size() != sz) {
+    throw std::invalid_argument{ "bad size" };
+  }
+  return offspring;
+}
+
+///////////////////////////
+// Termination condition //
+///////////////////////////
+
+/**
+ * `max` returns maximum fitness function value from `fs`.
+ *
+ * @param fs Fitness function values container.
+ * @returns Maximum value.
+ *
+ * @throws std::runtime_error Exception is raised if all `fs` elements are equal
+ * to `incalculable`.
+ */
+inline fitness
+max(const fitnesses& fs)
+{
+  const fitnesses calc{ select_calculable(fs, true) };
+  return *std::ranges::max_element(calc);
+}
+
+/**
+ * `max` returns maximum fitness function value for population `p` and database
+ * intermediary object `ff`.
+ *
+ * @tparam G Some `genotype` specialization.
+ * @param p Population.
+ * @param ff Database intermediary object.
+ * @returns Maximum value.
+ *
+ * @throws std::runtime_error Exception is raised if fitness function evaluates
+ * to `incalculable` for all genotypes from `p`.
+ */
+template<typename G>
+requires chromosome<G> fitness
+max(const population<G>& p, const fitness_db<G>& ff)
+{
+  return max(ff(p));
+}
+
+/**
+ * `max` returns maximum fitness function values for each generation from `gs`
+ * and database intermediary object `ff`.
+ *
+ * @tparam G Some `genotype` specialization.
+ * @param gs Sequence of generations.
+ * @param ff Database intermediary object.
+ * @returns Maximum values corresponding to each generation.
+ *
+ * @throws std::runtime_error Exception is raised if fitness function evaluates
+ * to `incalculable` for all genotypes from at least one generation.
+ */
+template<typename G>
+requires chromosome<G> fitnesses
+max(const generations<G>& gs, const fitness_db<G>& ff)
+{
+  fitnesses res{};
+  std::ranges::transform(gs,
+                         std::back_inserter(res),
+                         [&ff](const population<G>& p) { return max(p, ff); });
+  return res;
+}
+
+/**
+ * `min` returns minimum fitness function value from `fs`.
+ *
+ * @param fs Fitness function values container.
+ * @returns Minimum value.
+ *
+ * @throws std::runtime_error Exception is raised if all `fs` elements are equal
+ * to `incalculable`.
+ */
+inline fitness
+min(const fitnesses& fs)
+{
+  const fitnesses calc{ select_calculable(fs, true) };
+  return *std::ranges::min_element(calc);
+}
+
+/**
+ * `min` returns minimum fitness function value for population `p` and database
+ * intermediary object `ff`.
+ *
+ * @tparam G Some `genotype` specialization.
+ * @param p Population.
+ * @param ff Database intermediary object.
+ * @returns Minimum value.
+ *
+ * @throws std::runtime_error Exception is raised if fitness function evaluates
+ * to `incalculable` for all genotypes from `p`.
+ */
+template<typename G>
+requires chromosome<G> fitness
+min(const population<G>& p, const fitness_db<G>& ff)
+{
+  return min(ff(p));
+}
+
+/**
+ * `min` returns minimum fitness function values for each generation from `gs`
+ * and database intermediary object `ff`.
+ *
+ * @tparam G Some `genotype` specialization.
+ * @param gs Sequence of generations.
+ * @param ff Database intermediary object.
+ * @returns Minimum values corresponding to each generation.
+ *
+ * @throws std::runtime_error Exception is raised if fitness function evaluates
+ * to `incalculable` for all genotypes from at least one generation.
+ */
+template<typename G>
+requires chromosome<G> fitnesses
+min(const generations<G>& gs, const fitness_db<G>& ff)
+{
+  fitnesses res{};
+  std::ranges::transform(gs,
+                         std::back_inserter(res),
+                         [&ff](const population<G>& p) { return min(p, ff); });
+  return res;
+}
+
+/**
+ * `max_iterations_termination` returns condition, which terminates algorithm
+ * after performing `max` loop iterations.
+ *
+ * @tparam G Some `genotype` specialization.
+ * @param max Number of genetic algorithm loop iteration to perform (number of
+ * generations).
+ * @returns Predicate terminating genetic algorithm after `max` iterations.
+ */
+template<typename G>
+termination_condition_fn<G>
+max_iterations_termination(std::size_t max)
+{
+  return [=](std::size_t i, const generations<G>&) { return i == max; };
+}
+
+/**
+ * `max_fitness_improvement_termination` returns condition, which terminates
+ * algorithm after reaching fitness function \em plateau. The algorithm is
+ * terminated if after `n` last generations fitness function maximum has not
+ * improved \em relatively more than `frac` with respect to the whole
+ * evolutionary process.
+ *
+ * @tparam G Some `genotype` specialization.
+ * @param ff Database intermediary object.
+ * @param n Number of \em last generations.
+ * @param frac \em Plateau \em flatness.
+ * @returns Predicate terminating genetic algorithm after reaching fitness
+ * function \em plateau.
+ *
+ * @throws std::runtime_error Exception is raised if fitness function evaluates
+ * to `incalculable` for all genotypes from at least one generation.
+ * @note This condition is not intended for use with `evolution` argument
+ * `max_history` different than `0`.
+ *
+ * Example:
+ * @include self_adaptive.cc
+ *
+ * Result (might be different due to randomness):
+ * @verbinclude self_adaptive.out
+ *
+ * @note Evolution result is saved in separate file (not included).
+ */
+template<typename G>
+termination_condition_fn<G>
+max_fitness_improvement_termination(const fitness_db<G>& ff,
+                                    std::size_t n,
+                                    double frac)
+{
+  return [=]([[maybe_unused]] std::size_t i, const generations<G>& gs) {
+    assert(i == gs.size());
+    if (gs.size() <= n) {
+      return false;
+    } else {
+      const fitnesses fs{ max(gs, ff) };
+      const fitness min_last_n = *std::min_element(fs.end() - n, fs.end());
+      const double x = (max(fs) - min_last_n) / (max(fs) - min(fs));
+      return x <= frac;
+    }
+  };
+}
+
+/**
+ * `max_fitness_improvement_termination_2` returns condition, which terminates
+ * algorithm after reaching fitness function \em plateau. The algorithm is
+ * terminated if after `n` last generations fitness function maximum has not
+ * improved \em absolutely more than `delta` with respect to the whole
+ * evolutionary process.
+ *
+ * @tparam G Some `genotype` specialization.
+ * @param ff Database intermediary object.
+ * @param n Number of \em last generations.
+ * @param delta \em Plateau \em flatness.
+ * @returns Predicate terminating genetic algorithm after reaching fitness
+ * function \em plateau.
+ *
+ * @throws std::runtime_error Exception is raised if fitness function evaluates
+ * to `incalculable` for all genotypes from at least one generation.
+ * @note This condition is not intended for use with `evolution` argument
+ * `max_history` different than `0`.
+ */
+template<typename G>
+termination_condition_fn<G>
+max_fitness_improvement_termination_2(const fitness_db<G>& ff,
+                                      std::size_t n,
+                                      fitness delta)
+{
+  return [=]([[maybe_unused]] std::size_t i, const generations<G>& gs) {
+    assert(i == gs.size() && delta >= .0);
+    if (gs.size() <= n) {
+      return false;
+    } else {
+      const fitnesses fs{ max(gs, ff) };
+      const fitness max_0 = *std::max_element(fs.begin(), fs.end() - n);
+      const fitness max_1 = *std::max_element(fs.end() - n, fs.end());
+      return max_1 <= max_0 + delta;
+    }
+  };
+}
+
+/**
+ * `threshold_termination` returns condition, which terminates algorithm if at
+ * least one genotype fulfills predicate `thr`.
+ *
+ * @tparam G Some `genotype` specialization.
+ * @tparam F Predicate type.
+ * @param thr Predicate identifying searched genotype.
+ * @returns Predicate terminating genetic algorithm after genotype satisfying
+ * `thr` predicate is found.
+ */
+template<typename G, typename F>
+requires chromosome<G> && std::predicate<F, G> termination_condition_fn<G>
+threshold_termination(const F& thr)
+{
+  return [=](std::size_t, const generations<G>& gs) {
+    return gs.empty() ? false : std::ranges::any_of(gs.back(), thr);
+  };
+}
+
+/**
+ * `fitness_threshold_termination` returns condition, which terminates algorithm
+ * if at least one genotype reaches `thr` fitness function value with absolute
+ * precision `eps`.
+ *
+ * @tparam G Some `genotype` specialization.
+ * @param fd Database intermediary object.
+ * @param thr Fitness function value to achieve.
+ * @param eps Fitness function value absolute precision.
+ * @returns Predicate terminating genetic algorithm after genotype reaching
+ * fitness function value `thr` with absolute precision `eps` is found.
+ */
+template<typename G>
+termination_condition_fn<G>
+fitness_threshold_termination(const fitness_db<G>& fd, fitness thr, fitness eps)
+{
+  const auto f = [=](const G& g) { return std::fabs(fd(g) - thr) <= eps; };
+  return threshold_termination<G, decltype(f)>(f);
+}
+
+/////////////////////////////////////////////////
+// Concrete mutation & recombination operators //
+/////////////////////////////////////////////////
+
+namespace detail {
+
+/**
+ * `detail::locus` returns index of permuted number `x` in the ordered set of
+ * all permuted numbers.
+ *
+ * @tparam G Some `genotype` specialization.
+ * @param x Permuted number.
+ * @returns Index of `x`, i.e. `x - M`.
+ */
+template<typename G>
+requires permutation_chromosome<G> std::size_t
+locus(typename G::gene_t x)
+{
+  return static_cast<std::size_t>(x - G::genotype_t::lowest());
+}
+
+/**
+ * `detail::positions` returns inverse permutation of chain `c`.
+ *
+ * @tparam G Some `genotype` specialization.
+ * @param c Chain.
+ * @returns Array with position of permuted number `x` in `c` stored at index
+ * `locus<G>(x)`.
+ */
+template<typename G>
+requires permutation_chromosome<G> std::array<std::size_t, G::size()>
+positions(const typename G::chain_t& c)
+{
+  std::array<std::size_t, G::size()> res{};
+  for (std::size_t i = 0; i < G::size(); ++i) {
+    res[locus<G>(c[i])] = i;
+  }
+  return res;
+}
+
+/**
+ * `detail::cut_points` draws two cut points.
+ *
+ * @tparam G Some `genotype` specialization.
+ * @returns Pair of \em loci `a` and `b` satisfying `a <= b`.
+ */
+template<typename G>
+requires chromosome<G> std::pair<std::size_t, std::size_t>
+cut_points()
+{
+  const auto a = random_U<std::size_t>(0, G::size() - 1);
+  const auto b = random_U<std::size_t>(0, G::size() - 1);
+  return std::minmax(a, b);
+}
+
+// Value `v` clamped to `[lo, hi]`; equal to `std::clamp`, but written in form
+// which allows vectorization.
+template<typename T>
+T
+clamp(T v, T lo, T hi)
+{
+  v = v < lo ? lo : v;
+  return hi < v ? hi : v;
+}
+
+// Domain bounds of floating-point genotype `G` as contiguous arrays; computed
+// once per `G`.
+template<typename G>
+requires floating_point_chromosome<G>
+const std::pair<typename G::chain_t, typename G::chain_t>&
+bounds()
+{
+  static const std::pair<typename G::chain_t, typename G::chain_t> res{
+    chain_min(G::constraints()), chain_max(G::constraints())
+  };
+  return res;
+}
+
+// Adds `noise[i]` to `c[i]` and clamps result to `[lo[i], hi[i]]` for each
+// `i` with non-zero `mask[i]`. Branch-free loop over contiguous arrays of equal
+// width, hence vectorizable by compiler for available instruction set; result
+// is equal to gene-by-gene `range::clamp`.
+template<typename T, typename U, std::size_t N>
+void
+masked_add_n_clamp(chain<T, N>& c,
+                   const chain<T, N>& mask,
+                   const std::array<U, N>& noise,
+                   const chain<T, N>& lo,
+                   const chain<T, N>& hi)
+{
+  for (std::size_t i = 0; i < N; ++i) {
+    const T x = c[i];
+    const T l = lo[i];
+    const T h = hi[i];
+    T v = static_cast<T>(x + noise[i]);
+    v = v < l ? l : v;
+    v = h < v ? h : v;
+    c[i] = mask[i] != T{ 0 } ? v : x;
+  }
+}
+
+// Midpoints of `c0[i]` and `c1[i]` stored in `res[i]`. First (vectorizable)
+// pass is exact unless the sum overflows, i.e. it matches `std::midpoint`
+// whenever both values are at most half of the maximum in magnitude; remaining
+// genes are fixed up in the second pass.
+template<typename T, std::size_t N>
+void
+midpoints(chain<T, N>& res, const chain<T, N>& c0, const chain<T, N>& c1)
+{
+  constexpr T hi = std::numeric_limits<T>::max() / 2;
+  for (std::size_t i = 0; i < N; ++i) {
+    res[i] = (c0[i] + c1[i]) / 2;
+  }
+  for (std::size_t i = 0; i < N; ++i) {
+    if (!(std::fabs(c0[i]) <= hi && std::fabs(c1[i]) <= hi)) {
+      res[i] = std::midpoint(c0[i], c1[i]);
+    }
+  }
+}
+
+} // namespace detail
+
+/**
+ * `in_place_Gaussian_mutation` returns in-place Gaussian mutation operator
+ * with standard deviation `sigma` and gene mutation probability `p`.
+ *
+ * @tparam G Some `genotype` specialization.
+ * @param sigma Standard deviation.
+ * @param p Gene mutation probability.
+ * @returns In-place Gaussian mutation operator.
+ *
+ * Example:
+ * @include in_place_variation.cc
+ *
+ * Result (might be different due to randomness):
+ * @verbinclude in_place_variation.out
+ */
+template<typename G>
+requires floating_point_chromosome<G>
+auto
+in_place_Gaussian_mutation(typename G::gene_t sigma, probability p)
+{
+  return [=](G& g) {
+    const auto& [lo, hi] = detail::bounds<G>();
+    typename G::chain_t mask{};
+    std::array<decltype(sigma * random_N(0., 1.)), G::size()> noise{};
+    for (std::size_t i = 0; i < G::size(); ++i) {
+      if (success(p)) {
+        mask[i] = 1;
+        noise[i] = sigma * random_N(0., 1.);
+      }
+    }
+    auto res = g.data();
+    detail::masked_add_n_clamp(res, mask, noise, lo, hi);
+    g = G{ res };
+  };
+}
+
+/**
+ * `Gaussian_mutation` returns Gaussian mutation operator with standard
+ * deviation `sigma` and gene mutation probability `p`.
+ *
+ * @tparam G Some `genotype` specialization.
+ * @param sigma Standard deviation.
+ * @param p Gene mutation probability.
+ * @returns Gaussian mutation operator.
+ *
+ * Example:
+ * @include Gaussian_mutation.cc
+ *
+ * Result (might be different due to randomness):
+ * @verbinclude Gaussian_mutation.out
+ *
+ * @note Evolution result is saved in separate file (not included).
+ */
+template<typename G>
+requires floating_point_chromosome<G>
+auto
+Gaussian_mutation(typename G::gene_t sigma, probability p)
+{
+  return detail::out_of_place<G>(in_place_Gaussian_mutation<G>(sigma, p));
+}
+
+/**
+ * `self_adaptive_mutation` returns self adaptive mutation operator with
+ * parameters `a0` and `a1`.
+ *
+ * @tparam G Some `genotype` specialization.
+ * @param a0 Self adaptive mutation parameter.
+ * @param a1 Self adaptive mutation parameter.
+ * @returns Self adaptive mutation operator.
+ *
+ * @note Genotype consists of \f$n\f$ object genes followed by \f$n\f$ step
+ * sizes (cf. `self_adaptive_variation_domain`). Step sizes are updated first
+ * according to \f$\sigma'_i = \sigma_i \exp(\tau' N(0, 1) + \tau N_i(0,
+ * 1))\f$, where \f$\tau' = a_0 / \sqrt{2n}\f$ and \f$\tau = a_1 /
+ * \sqrt{2\sqrt{n}}\f$, and then object genes are mutated with them.
+ *
+ * @note Due to documentation processing problem the above template declaration
+ * is incorrect. Corrected declaration:
+ * @code
+ * template<typename G>
+ * requires floating_point_chromosome<G> && (G::size() % 2 == 0)
+ * auto self_adaptive_mutation(typename G::gene_t a0, typename G::gene_t a1)
+ * @endcode
+ *
+ * Example:
+ * @include self_adaptive.cc
+ *
+ * Result (might be different due to randomness):
+ * @verbinclude self_adaptive.out
+ *
+ * @note Evolution result is saved in separate file (not included).
+ */
+template<typename G>
+requires floating_point_chromosome<G>
+  /**
+   * \cond
+   */
+  &&(G::size() % 2 == 0)
+  // This unfortunately cannot be processed properly by documentation system.
+  /**
+   * \endcond
+   */
+  auto self_adaptive_mutation(typename G::gene_t a0, typename G::gene_t a1)
+{
+  return [=](const G& g) {
+    using type = typename G::gene_t;
+    constexpr std::size_t n = G::size() / 2;
+    const auto& [lo, hi] = detail::bounds<G>();
+    const type p0 = random_N(0., 1.) * a0 / std::sqrt(2 * n);
+    const type t1 = a1 / std::sqrt(2 * std::sqrt(n));
+    std::array<decltype(random_N(0., 1.)), n> zs{};
+    std::array<decltype(random_N(0., 1.)), n> zx{};
+    for (std::size_t i = 0; i < n; ++i) {
+      zs[i] = random_N(0., 1.);
+      zx[i] = random_N(0., 1.);
+    }
+    auto c = g.data();
+    for (std::size_t i = 0; i < n; ++i) {
+      const type sigma = detail::clamp(
+        static_cast<type>(c[i + n] * std::exp(p0 + t1 * zs[i])),
+        lo[i + n],
+        hi[i + n]);
+      c[i + n] = sigma;
+      c[i] = detail::clamp(static_cast<type>(c[i] + sigma * zx[i]), lo[i], hi[i]);
+    }
+    return population<G>{ G{ c } };
+  };
+}
+
+/**
+ * `one_sigma_self_adaptive_mutation` returns self adaptive mutation operator
+ * with one step size \f$\sigma\f$ (stored as the last gene) shared by all
+ * object genes and learning rate parameter `a`.
+ *
+ * @tparam G Some `genotype` specialization.
+ * @param a Self adaptive mutation parameter.
+ * @returns Self adaptive mutation operator.
+ *
+ * @note Step size is updated first according to \f$\sigma' = \sigma \exp(\tau
+ * N(0, 1))\f$, where \f$\tau = a / \sqrt{n}\f$, and then object genes are
+ * mutated with \f$\sigma'\f$.
+ *
+ * @note Due to documentation processing problem the above template declaration
+ * is incorrect. Corrected declaration:
+ * @code
+ * template<typename G>
+ * requires floating_point_chromosome<G> && (G::size() > 1)
+ * auto one_sigma_self_adaptive_mutation(typename G::gene_t a)
+ * @endcode
+ *
+ * Example:
+ * @include self_adaptive_mutation.cc
+ *
+ * Result (might be different due to randomness):
+ * @verbinclude self_adaptive_mutation.out
+ */
+template<typename G>
+requires floating_point_chromosome<G>
+  /**
+   * \cond
+   */
+  &&(G::size() > 1)
+  // This unfortunately cannot be processed properly by documentation system.
+  /**
+   * \endcond
+   */
+  auto one_sigma_self_adaptive_mutation(typename G::gene_t a)
+{
+  return [=](const G& g) {
+    using type = typename G::gene_t;
+    constexpr std::size_t n = G::size() - 1;
+    const auto& [lo, hi] = detail::bounds<G>();
+    const type t = a / std::sqrt(n);
+    auto c = g.data();
+    const type sigma = detail::clamp(
+      static_cast<type>(c[n] * std::exp(t * random_N(0., 1.))), lo[n], hi[n]);
+    std::array<decltype(random_N(0., 1.)), n> zx{};
+    for (auto& z : zx) {
+      z = random_N(0., 1.);
+    }
+    for (std::size_t i = 0; i < n; ++i) {
+      c[i] = detail::clamp(static_cast<type>(c[i] + sigma * zx[i]), lo[i], hi[i]);
+    }
+    c[n] = sigma;
+    return population<G>{ G{ c } };
+  };
+}
+
+/**
+ * `traced_swap_mutation` is swap mutation reporting changed \em loci.
+ *
+ * @tparam G Some `genotype` specialization.
+ * @param g Genotype.
+ * @returns Mutated genotype and \em loci of swapped genes.
+ *
+ * Example:
+ * @include delta_fitness.cc
+ *
+ * Result (might be different due to randomness):
+ * @verbinclude delta_fitness.out
+ */
+template<typename G>
+requires uniform_chromosome<G> std::tuple<G, loci>
+traced_swap_mutation(const G& g)
+{
+  const std::size_t n = G::size();
+  auto d = g.data();
+  const auto i = random_U<std::size_t>(0, n - 1);
+  const auto j = random_U<std::size_t>(0, n - 1);
+  std::swap(d[i], d[j]);
+  return std::tuple<G, loci>{ G{ d }, i == j ? loci{ i } : loci{ i, j } };
+}
+
+/**
+ * `in_place_swap_mutation` is in-place swap mutation.
+ *
+ * @tparam G Some `genotype` specialization.
+ * @param g Genotype to be mutated.
+ *
+ * Example:
+ * @include in_place_variation.cc
+ *
+ * Result (might be different due to randomness):
+ * @verbinclude in_place_variation.out
+ */
+template<typename G>
+requires uniform_chromosome<G>
+void
+in_place_swap_mutation(G& g)
+{
+  const std::size_t n = G::size();
+  auto d = g.data();
+  const auto i = random_U<std::size_t>(0, n - 1);
+  const auto j = random_U<std::size_t>(0, n - 1);
+  std::swap(d[i], d[j]);
+  g = G{ d };
+}
+
+/**
+ * `swap_mutation` is swap mutation.
+ *
+ * @tparam G Some `genotype` specialization.
+ * @param g Genotype.
+ * @returns Population containing mutated genotype.
+ *
+ * Example:
+ * @include variation.cc
+ *
+ * Result (might be different due to randomness):
+ * @verbinclude variation.out
+ */
+template<typename G>
+requires uniform_chromosome<G> population<G>
+swap_mutation(const G& g)
+{
+  population<G> res{ g };
+  in_place_swap_mutation(res[0]);
+  return res;
+}
+
+/**
+ * `permutation_moves` holds problem-specific functions computing fitness
+ * function value change (child minus parent) caused by local moves on
+ * permutation chain `c`, and optional candidate lists pruning neighborhood.
+ * Each delta function is expected to be \f$O(1)\f$; empty function disables
+ * respective neighborhood.
+ *
+ * @tparam G Some `genotype` specialization.
+ *
+ * Example:
+ * @include permutation_local_search.cc
+ *
+ * Result (might be different due to randomness):
+ * @verbinclude permutation_local_search.out
+ */
+template<typename G>
+requires permutation_chromosome<G>
+struct permutation_moves
+{
+  /**
+   * `permutation_moves::chain_t` is genetic chain type of `G`.
+   */
+  using chain_t = typename G::chain_t;
+
+  /**
+   * `permutation_moves::swap` returns fitness change caused by exchange of
+   * genes at positions `i` and `j`, where `i < j`.
+   */
+  std::function<fitness(const chain_t& c, std::size_t i, std::size_t j)> swap{};
+
+  /**
+   * `permutation_moves::two_opt` returns fitness change caused by reversal of
+   * segment of genes at positions from `[i, j]`, where `i < j`.
+   */
+  std::function<fitness(const chain_t& c, std::size_t i, std::size_t j)>
+    two_opt{};
+
+  /**
+   * `permutation_moves::or_opt` returns fitness change caused by moving
+   * segment of `l` genes starting at position `i` directly after gene at
+   * position `j`, where `j` is outside of `[i - 1, i + l - 1]` and `i + l <= N`.
+   * Relative order of genes in the segment is preserved. For cyclic
+   * permutations (e.g. tours) moving of the first segment after the last gene
+   * is a rotation, so its fitness change is zero.
+   */
+  std::function<fitness(const chain_t& c,
+                        std::size_t i,
+                        std::size_t l,
+                        std::size_t j)>
+    or_opt{};
+
+  /**
+   * `permutation_moves::candidates` contains for each permuted number `x` at
+   * index `x - G::genotype_t::lowest()` numbers, which should be tried as its
+   * new neighbours (e.g. nearest cities in TSP). Empty vector means that whole
+   * neighborhood is searched.
+   */
+  std::vector<std::vector<typename G::gene_t>> candidates{};
+
+  /**
+   * `permutation_moves::or_opt_max` is maximal segment length for or-opt
+   * moves.
+   */
+  std::size_t or_opt_max{ 3 };
+
+  /**
+   * `permutation_moves::min_gain` is minimal fitness change of move treated
+   * as improvement (it prevents cycling caused by rounding errors).
+   */
+  fitness min_gain{ 1e-9 };
+};
+
+/**
+ * `permutation_local_search` returns mutation, which improves genotype by
+ * first-improvement local search over swap, 2-opt and or-opt neighborhoods
+ * defined by `moves`. Search stops in local optimum or after `max_moves`
+ * improving moves.
+ *
+ * @tparam G Some `genotype` specialization.
+ * @param moves Delta functions and candidate lists.
+ * @param max_moves Maximal number of improving moves applied.
+ * @returns Local search mutation operator.
+ *
+ * @note With candidate lists of length \f$k\f$ single neighborhood scan costs
+ * \f$O(kN)\f$ delta evaluations instead of \f$O(N^2)\f$. Scan starts at
+ * random position.
+ *
+ * Example:
+ * @include permutation_local_search.cc
+ *
+ * Result (might be different due to randomness):
+ * @verbinclude permutation_local_search.out
+ */
+template<typename G>
+requires permutation_chromosome<G>
+auto
+permutation_local_search(const permutation_moves<G>& moves,
+                         std::size_t max_moves =
+                           std::numeric_limits<std::size_t>::max())
+{
+  return [=](const G& g) -> population<G> {
+    const std::size_t n = G::size();
+    auto c = g.data();
+    auto pos = detail::positions<G>(c);
+    const auto update = [&](std::size_t first, std::size_t last) {
+      for (std::size_t k = first; k < last; ++k) {
+        pos[detail::locus<G>(c[k])] = k;
+      }
+    };
+    // Tries moves joining gene at position `i` with gene at position `j`;
+    // returns true if improving move was applied.
+    const auto improve = [&](std::size_t i, std::size_t j) {
+      if (i == j) {
+        return false;
+      }
+      const auto [a, b] = std::minmax(i, j);
+      if (moves.swap && moves.swap(c, a, b) > moves.min_gain) {
+        std::swap(c[a], c[b]);
+        update(a, a + 1);
+        update(b, b + 1);
+        return true;
+      }
+      if (moves.two_opt && b - a > 1 &&
+          moves.two_opt(c, a + 1, b) > moves.min_gain) {
+        std::reverse(std::begin(c) + a + 1, std::begin(c) + b + 1);
+        update(a + 1, b + 1);
+        return true;
+      }
+      if (moves.or_opt) {
+        for (std::size_t l = 1; l <= moves.or_opt_max && i + l <= n; ++l) {
+          if (j + 1 >= i && j < i + l) {
+            continue;
+          }
+          if (moves.or_opt(c, i, l, j) > moves.min_gain) {
+            if (j >= i + l) {
+              std::rotate(std::begin(c) + i,
+                          std::begin(c) + i + l,
+                          std::begin(c) + j + 1);
+              update(i, j + 1);
+            } else {
+              std::rotate(std::begin(c) + j + 1,
+                          std::begin(c) + i,
+                          std::begin(c) + i + l);
+              update(j + 1, i + l);
+            }
+            return true;
+          }
+        }
+      }
+      return false;
+    };
+    std::size_t applied{ 0 };
+    for (bool improved = true; improved && applied < max_moves;) {
+      improved = false;
+      const auto start = random_U<std::size_t>(0, n - 1);
+      for (std::size_t s = 0; s < n && applied < max_moves; ++s) {
+        const std::size_t i = (start + s) % n;
+        if (moves.candidates.empty()) {
+          for (std::size_t j = 0; j < n; ++j) {
+            if (improve(i, j)) {
+              improved = true;
+              ++applied;
+              break;
+            }
+          }
+        } else {
+          for (auto x : moves.candidates[detail::locus<G>(c[i])]) {
+            if (improve(i, pos[detail::locus<G>(x)])) {
+              improved = true;
+              ++applied;
+              break;
+            }
+          }
+        }
+      }
+    }
+    return population<G>{ G{ c } };
+  };
+}
+
+/**
+ * `traced_random_reset` returns random reset mutation with parameter `p`
+ * reporting changed \em loci.
+ *
+ * @tparam G Some `genotype` specialization.
+ * @param p Gene mutation probability.
+ * @returns Traced random reset mutation operator.
+ *
+ * Example:
+ * @include delta_fitness.cc
+ *
+ * Result (might be different due to randomness):
+ * @verbinclude delta_fitness.out
+ */
+template<typename G>
+requires floating_point_chromosome<G> || integer_chromosome<G> ||
+  binary_chromosome<G>
+auto
+traced_random_reset(probability p)
+{
+  return [=](const G& g) -> std::tuple<G, loci> {
+    G res{ g };
+    loci changed{};
+    for (std::size_t i = 0; i < G::size(); ++i) {
+      if (success(p)) {
+        res.random_reset(i);
+        changed.push_back(i);
+      }
+    }
+    return std::tuple<G, loci>{ res, changed };
+  };
+}
+
+/**
+ * `in_place_random_reset` returns in-place random reset mutation with
+ * parameter `p`.
+ *
+ * @tparam G Some `genotype` specialization.
+ * @param p Gene mutation probability.
+ * @returns In-place random reset mutation operator.
+ *
+ * Example:
+ * @include in_place_variation.cc
+ *
+ * Result (might be different due to randomness):
+ * @verbinclude in_place_variation.out
+ */
+template<typename G>
+requires floating_point_chromosome<G> || integer_chromosome<G> ||
+  binary_chromosome<G>
+auto
+in_place_random_reset(probability p)
+{
+  return [=](G& g) {
+    for (std::size_t i = 0; i < G::size(); ++i) {
+      if (success(p)) {
+        g.random_reset(i);
+      }
+    }
+  };
+}
+
+/**
+ * `random_reset` returns random reset mutation with parameter `p`.
+ *
+ * @tparam G Some `genotype` specialization.
+ * @param p Gene mutation probability.
+ * @returns Random reset mutation operator.
+ */
+template<typename G>
+requires floating_point_chromosome<G> || integer_chromosome<G> ||
+  binary_chromosome<G>
+auto
+random_reset(probability p)
+{
+  return detail::out_of_place<G>(in_place_random_reset<G>(p));
+}
+
+/**
+ * `traced_bit_flipping` returns bit-flipping mutation with parameter `p`
+ * reporting changed \em loci.
+ *
+ * @tparam G Some `genotype` specialization.
+ * @param p Gene mutation probability.
+ * @returns Traced bit-flipping mutation operator.
+ *
+ * @note Expected cost is proportional to number of flipped genes.
+ *
+ * Example:
+ * @include delta_fitness.cc
+ *
+ * Result (might be different due to randomness):
+ * @verbinclude delta_fitness.out
+ */
+template<typename G>
+requires binary_chromosome<G>
+auto
+traced_bit_flipping(probability p)
+{
+  return [=](const G& g) -> std::tuple<G, loci> {
+    auto d = g.data();
+    loci changed{};
+    detail::for_each_success(G::size(), p, [&](std::size_t i) {
+      d[i] = !d[i];
+      changed.push_back(i);
+    });
+    return std::tuple<G, loci>{ G{ d }, changed };
+  };
+}
+
+/**
+ * `in_place_bit_flipping` returns in-place bit-flipping mutation with
+ * parameter `p`.
+ *
+ * @tparam G Some `genotype` specialization.
+ * @param p Gene mutation probability.
+ * @returns In-place bit-flipping mutation operator.
+ *
+ * @note Expected cost is proportional to number of flipped genes.
+ *
+ * Example:
+ * @include in_place_variation.cc
+ *
+ * Result (might be different due to randomness):
+ * @verbinclude in_place_variation.out
+ */
+template<typename G>
+requires binary_chromosome<G>
+auto
+in_place_bit_flipping(probability p)
+{
+  return [=](G& g) {
+    auto d = g.data();
+    bool changed = false;
+    detail::for_each_success(G::size(), p, [&](std::size_t i) {
+      d[i] = !d[i];
+      changed = true;
+    });
+    if (changed) {
+      g = G{ d };
+    }
+  };
+}
+
+/**
+ * `bit_flipping` returns bit-flipping mutation with parameter `p`.
+ *
+ * @tparam G Some `genotype` specialization.
+ * @param p Gene mutation probability.
+ * @returns Bit-flipping mutation operator.
+ *
+ * @note Expected cost is proportional to number of flipped genes.
+ */
+template<typename G>
+requires binary_chromosome<G>
+auto
+bit_flipping(probability p)
+{
+  return detail::out_of_place<G>(in_place_bit_flipping<G>(p));
+}
+
+/**
+ * `in_place_arithmetic_recombination` is in-place arithmetic recombination.
+ *
+ * @tparam Some `G` specialization.
+ * @param g0 First parent.
+ * @param g1 Secong parent.
+ * @param c0 Slot for offspring genotype.
+ * @returns Number of children (1).
+ *
+ * Example:
+ * @include in_place_variation.cc
+ *
+ * Result (might be different due to randomness):
+ * @verbinclude in_place_variation.out
+ */
+template<typename G>
+requires floating_point_chromosome<G> std::size_t
+in_place_arithmetic_recombination(const G& g0, const G& g1, G& c0, G&)
+{
+  typename G::chain_t res{};
+  detail::midpoints(res, g0.data(), g1.data());
+  c0 = G{ res };
+  return 1;
+}
+
+/**
+ * `arithmetic_recombination` is arithmetic recombination.
+ *
+ * @tparam Some `G` specialization.
+ * @param g0 First parent.
+ * @param g1 Secong parent.
+ * @returns Population containing one offspring genotype.
+ *
+ * Example:
+ * @include self_adaptive.cc
+ *
+ * Result (might be different due to randomness):
+ * @verbinclude self_adaptive.out
+ *
+ * @note Evolution result is saved in separate file (not included).
+ */
+template<typename G>
+requires floating_point_chromosome<G> population<G>
+arithmetic_recombination(const G& g0, const G& g1)
+{
+  return detail::out_of_place<G>(in_place_arithmetic_recombination<G>)(g0, g1);
+}
+
+/**
+ * `in_place_single_arithmetic_recombination` is in-place single arithmetic
+ * recombination.
+ *
+ * @tparam Some `G` specialization.
+ * @param g0 First parent.
+ * @param g1 Secong parent.
+ * @param c0 Slot for the first child.
+ * @param c1 Slot for the second child.
+ * @returns Number of children (2).
+ *
+ * Example:
+ * @include in_place_variation.cc
+ *
+ * Result (might be different due to randomness):
+ * @verbinclude in_place_variation.out
+ */
+template<typename G>
+requires floating_point_chromosome<G> std::size_t
+in_place_single_arithmetic_recombination(const G& g0,
+                                         const G& g1,
+                                         G& c0,
+                                         G& c1)
+{
+  c0 = g0;
+  c1 = g1;
+  const auto cp = random_U<std::size_t>(0, G::size() - 1);
+  const auto mid = std::midpoint(c0.value(cp), c1.value(cp));
+  c0.value(cp, mid);
+  c1.value(cp, mid);
+  return 2;
+}
+
+/**
+ * `single_arithmetic_recombination` is single arithmetic recombination.
+ *
+ * @tparam Some `G` specialization.
+ * @param g0 First parent.
+ * @param g1 Secong parent.
+ * @returns Population containing two offspring genotypes.
+ *
+ * Example:
+ * @include recombination.cc
+ *
+ * Result (might be different due to randomness):
+ * @verbinclude recombination.out
+ */
+template<typename G>
+requires floating_point_chromosome<G> population<G>
+single_arithmetic_recombination(const G& g0, const G& g1)
+{
+  return detail::out_of_place<G>(in_place_single_arithmetic_recombination<G>)(
+    g0, g1);
+}
+
+/**
+ * `in_place_one_point_xover` is in-place one-point crossover recombination.
+ *
+ * @tparam Some `G` specialization.
+ * @param g0 First parent.
+ * @param g1 Secong parent.
+ * @param c0 Slot for the first child.
+ * @param c1 Slot for the second child.
+ * @returns Number of children (2).
+ *
+ * Example:
+ * @include in_place_variation.cc
+ *
+ * Result (might be different due to randomness):
+ * @verbinclude in_place_variation.out
+ */
+template<typename G>
+requires floating_point_chromosome<G> || integer_chromosome<G> ||
+  binary_chromosome<G>
+    std::size_t
+    in_place_one_point_xover(const G& g0, const G& g1, G& c0, G& c1)
+{
+  const std::size_t n = G::size();
+  const auto cp = random_U<std::size_t>(0, n - 1);
+  if constexpr (binary_chromosome<G>) {
+    auto p0 = pack(g0.data());
+    auto p1 = pack(g1.data());
+    exchange(p0, p1, segment_mask<G::size()>(cp, n));
+    c0 = G{ unpack<G::size()>(p0) };
+    c1 = G{ unpack<G::size()>(p1) };
+  } else {
+    auto d0 = g0.data();
+    auto d1 = g1.data();
+    std::swap_ranges(std::begin(d0) + cp, std::end(d0), std::begin(d1) + cp);
+    c0 = G{ d0 };
+    c1 = G{ d1 };
+  }
+  return 2;
+}
+
+/**
+ * `one_point_xover` is one-point crossover recombination.
+ *
+ * @tparam Some `G` specialization.
+ * @param g0 First parent.
+ * @param g1 Secong parent.
+ * @returns Population containing two offspring genotypes.
+ *
+ * Example:
+ * @include recombination.cc
+ *
+ * Result (might be different due to randomness):
+ * @verbinclude recombination.out
+ */
+template<typename G>
+requires floating_point_chromosome<G> || integer_chromosome<G> ||
+  binary_chromosome<G>
+    population<G>
+    one_point_xover(const G& g0, const G& g1)
+{
+  return detail::out_of_place<G>(in_place_one_point_xover<G>)(g0, g1);
+}
+
+/**
+ * `in_place_two_point_xover` is in-place two-point crossover recombination
+ * (cf. `two_point_xover`).
+ *
+ * @tparam Some `G` specialization.
+ * @param g0 First parent.
+ * @param g1 Secong parent.
+ * @param c0 Slot for the first child.
+ * @param c1 Slot for the second child.
+ * @returns Number of children (2).
+ *
+ * Example:
+ * @include in_place_variation.cc
+ *
+ * Result (might be different due to randomness):
+ * @verbinclude in_place_variation.out
+ */
+template<typename G>
+requires floating_point_chromosome<G> || integer_chromosome<G> ||
+  binary_chromosome<G>
+    std::size_t
+    in_place_two_point_xover(const G& g0, const G& g1, G& c0, G& c1)
+{
+  const auto [a, b] = detail::cut_points<G>();
+  if constexpr (binary_chromosome<G>) {
+    auto p0 = pack(g0.data());
+    auto p1 = pack(g1.data());
+    exchange(p0, p1, segment_mask<G::size()>(a, b + 1));
+    c0 = G{ unpack<G::size()>(p0) };
+    c1 = G{ unpack<G::size()>(p1) };
+  } else {
+    auto d0 = g0.data();
+    auto d1 = g1.data();
+    std::swap_ranges(
+      std::begin(d0) + a, std::begin(d0) + b + 1, std::begin(d1) + a);
+    c0 = G{ d0 };
+    c1 = G{ d1 };
+  }
+  return 2;
+}
+
+/**
+ * `two_point_xover` is two-point crossover recombination, i.e. genes between
+ * two random cut points (inclusive) are exchanged.
+ *
+ * @tparam Some `G` specialization.
+ * @param g0 First parent.
+ * @param g1 Secong parent.
+ * @returns Population containing two offspring genotypes.
+ *
+ * @note For binary representation exchange is performed on packed chains
+ * (64 genes at once).
+ *
+ * Example:
+ * @include packed_chain.cc
+ *
+ * Result (might be different due to randomness):
+ * @verbinclude packed_chain.out
+ */
+template<typename G>
+requires floating_point_chromosome<G> || integer_chromosome<G> ||
+  binary_chromosome<G>
+    population<G>
+    two_point_xover(const G& g0, const G& g1)
+{
+  return detail::out_of_place<G>(in_place_two_point_xover<G>)(g0, g1);
+}
+
+/**
+ * `in_place_uniform_xover` is in-place uniform crossover recombination (cf.
+ * `uniform_xover`).
+ *
+ * @tparam Some `G` specialization.
+ * @param g0 First parent.
+ * @param g1 Secong parent.
+ * @param c0 Slot for the first child.
+ * @param c1 Slot for the second child.
+ * @returns Number of children (2).
+ *
+ * Example:
+ * @include in_place_variation.cc
+ *
+ * Result (might be different due to randomness):
+ * @verbinclude in_place_variation.out
+ */
+template<typename G>
+requires floating_point_chromosome<G> || integer_chromosome<G> ||
+  binary_chromosome<G>
+    std::size_t
+    in_place_uniform_xover(const G& g0, const G& g1, G& c0, G& c1)
+{
+  if constexpr (binary_chromosome<G>) {
+    auto p0 = pack(g0.data());
+    auto p1 = pack(g1.data());
+    exchange(p0, p1, uniform_mask<G::size()>());
+    c0 = G{ unpack<G::size()>(p0) };
+    c1 = G{ unpack<G::size()>(p1) };
+  } else {
+    auto d0 = g0.data();
+    auto d1 = g1.data();
+    for (std::size_t i = 0; i < G::size(); ++i) {
+      if (success(.5)) {
+        std::swap(d0[i], d1[i]);
+      }
+    }
+    c0 = G{ d0 };
+    c1 = G{ d1 };
+  }
+  return 2;
+}
+
+/**
+ * `uniform_xover` is uniform crossover recombination, i.e. each pair of genes
+ * is exchanged with probability \f$\frac{1}{2}\f$.
+ *
+ * @tparam Some `G` specialization.
+ * @param g0 First parent.
+ * @param g1 Secong parent.
+ * @returns Population containing two offspring genotypes.
+ *
+ * @note For binary representation exchange is performed on packed chains
+ * with one pseudo-random word per 64 genes.
+ *
+ * Example:
+ * @include packed_chain.cc
+ *
+ * Result (might be different due to randomness):
+ * @verbinclude packed_chain.out
+ */
+template<typename G>
+requires floating_point_chromosome<G> || integer_chromosome<G> ||
+  binary_chromosome<G>
+    population<G>
+    uniform_xover(const G& g0, const G& g1)
+{
+  return detail::out_of_place<G>(in_place_uniform_xover<G>)(g0, g1);
+}
+
+/**
+ * `in_place_cut_n_crossfill` is in-place cut-and-crossfill recombination.
+ *
+ * @tparam Some `G` specialization.
+ * @param g0 First parent.
+ * @param g1 Secong parent.
+ * @param c0 Slot for the first child.
+ * @param c1 Slot for the second child.
+ * @returns Number of children (2).
+ *
+ * Example:
+ * @include in_place_variation.cc
+ *
+ * Result (might be different due to randomness):
+ * @verbinclude in_place_variation.out
+ */
+template<typename G>
+requires permutation_chromosome<G> std::size_t
+in_place_cut_n_crossfill(const G& g0, const G& g1, G& c0, G& c1)
+{
+  const auto f = [cp = random_U<std::size_t>(1, G::size() - 1)](const G& g,
+                                                                auto d) {
+    std::array<bool, G::size()> used{};
+    for (std::size_t i = 0; i < cp; ++i) {
+      used[detail::locus<G>(d[i])] = true;
+    }
+    auto it = std::begin(d);
+    std::advance(it, cp);
+    for (auto x : g) {
+      if (const auto l = detail::locus<G>(x); !used[l]) {
+        used[l] = true;
+        *it++ = x;
+      }
+    }
+    assert(it == std::end(d));
+    return d;
+  };
+  c0 = G{ f(g1, g0.data()) };
+  c1 = G{ f(g0, g1.data()) };
+  return 2;
+}
+
+/**
+ * `cut_n_crossfill` is cut-and-crossfill recombination.
+ *
+ * @tparam Some `G` specialization.
+ * @param g0 First parent.
+ * @param g1 Secong parent.
+ * @returns Population containing two offspring genotypes.
+ *
+ * Example:
+ * @include variation.cc
+ *
+ * Result (might be different due to randomness):
+ * @verbinclude variation.out
+ */
+template<typename G>
+requires permutation_chromosome<G> population<G>
+cut_n_crossfill(const G& g0, const G& g1)
+{
+  return detail::out_of_place<G>(in_place_cut_n_crossfill<G>)(g0, g1);
+}
+
+namespace detail {
+
+/**
+ * `detail::pmx` creates child of partially mapped crossover.
+ *
+ * @tparam G Some `genotype` specialization.
+ * @param c0 Chain of the parent donating segment.
+ * @param c1 Chain of the parent donating remaining genes.
+ * @param a Segment begin (inclusive).
+ * @param b Segment end (inclusive).
+ * @returns Chain of the child.
+ */
+template<typename G>
+requires permutation_chromosome<G>
+typename G::chain_t
+pmx(const typename G::chain_t& c0,
+    const typename G::chain_t& c1,
+    std::size_t a,
+    std::size_t b)
+{
+  const auto pos1 = positions<G>(c1);
+  std::array<bool, G::size()> in_segment{};
+  auto res = c1;
+  for (std::size_t i = a; i <= b; ++i) {
+    res[i] = c0[i];
+    in_segment[locus<G>(c0[i])] = true;
+  }
+  for (std::size_t i = a; i <= b; ++i) {
+    if (in_segment[locus<G>(c1[i])]) {
+      continue;
+    }
+    // Mapping chains are disjoint, hence all walks take linear time in total.
+    std::size_t j = i;
+    do {
+      j = pos1[locus<G>(c0[j])];
+    } while (a <= j && j <= b);
+    res[j] = c1[i];
+  }
+  return res;
+}
+
+/**
+ * `detail::ox` creates child of order crossover.
+ *
+ * @tparam G Some `genotype` specialization.
+ * @param c0 Chain of the parent donating segment.
+ * @param c1 Chain of the parent donating order of remaining genes.
+ * @param a Segment begin (inclusive).
+ * @param b Segment end (inclusive).
+ * @returns Chain of the child.
+ */
+template<typename G>
+requires permutation_chromosome<G>
+typename G::chain_t
+ox(const typename G::chain_t& c0,
+   const typename G::chain_t& c1,
+   std::size_t a,
+   std::size_t b)
+{
+  const std::size_t n = G::size();
+  std::array<bool, G::size()> used{};
+  auto res = c0;
+  for (std::size_t i = a; i <= b; ++i) {
+    used[locus<G>(c0[i])] = true;
+  }
+  for (std::size_t k = 0, j = (b + 1) % n; k < n; ++k) {
+    if (const auto x = c1[(b + 1 + k) % n]; !used[locus<G>(x)]) {
+      res[j] = x;
+      j = (j + 1) % n;
+    }
+  }
+  return res;
+}
+
+} // namespace detail
+
+/**
+ * `partially_mapped_xover` is partially mapped crossover (PMX) recombination.
+ *
+ * @tparam Some `G` specialization.
+ * @param g0 First parent.
+ * @param g1 Secong parent.
+ * @returns Population containing two offspring genotypes.
+ *
+ * @note Time complexity is linear in genotype length.
+ *
+ * Example:
+ * @include permutation_xover.cc
+ *
+ * Result (might be different due to randomness):
+ * @verbinclude permutation_xover.out
+ */
+template<typename G>
+requires permutation_chromosome<G> population<G>
+partially_mapped_xover(const G& g0, const G& g1)
+{
+  const auto [a, b] = detail::cut_points<G>();
+  return population<G>{ G{ detail::pmx<G>(g0.data(), g1.data(), a, b) },
+                        G{ detail::pmx<G>(g1.data(), g0.data(), a, b) } };
+}
+
+/**
+ * `order_xover` is order crossover recombination.
+ *
+ * @tparam Some `G` specialization.
+ * @param g0 First parent.
+ * @param g1 Secong parent.
+ * @returns Population containing two offspring genotypes.
+ *
+ * @note Time complexity is linear in genotype length.
+ *
+ * Example:
+ * @include permutation_xover.cc
+ *
+ * Result (might be different due to randomness):
+ * @verbinclude permutation_xover.out
+ */
+template<typename G>
+requires permutation_chromosome<G> population<G>
+order_xover(const G& g0, const G& g1)
+{
+  const auto [a, b] = detail::cut_points<G>();
+  return population<G>{ G{ detail::ox<G>(g0.data(), g1.data(), a, b) },
+                        G{ detail::ox<G>(g1.data(), g0.data(), a, b) } };
+}
+
+/**
+ * `cycle_xover` is cycle crossover recombination.
+ *
+ * @tparam Some `G` specialization.
+ * @param g0 First parent.
+ * @param g1 Secong parent.
+ * @returns Population containing two offspring genotypes.
+ *
+ * @note Time complexity is linear in genotype length.
+ *
+ * Example:
+ * @include permutation_xover.cc
+ *
+ * Result (might be different due to randomness):
+ * @verbinclude permutation_xover.out
+ */
+template<typename G>
+requires permutation_chromosome<G> population<G>
+cycle_xover(const G& g0, const G& g1)
+{
+  const auto& c0 = g0.data();
+  const auto& c1 = g1.data();
+  const auto pos0 = detail::positions<G>(c0);
+  std::array<bool, G::size()> visited{};
+  auto d0 = c0;
+  auto d1 = c1;
+  for (std::size_t start = 0, cycle = 0; start < G::size(); ++start) {
+    if (visited[start]) {
+      continue;
+    }
+    for (std::size_t i = start; !visited[i]; i = pos0[detail::locus<G>(c1[i])]) {
+      visited[i] = true;
+      if (cycle % 2) {
+        std::swap(d0[i], d1[i]);
+      }
+    }
+    ++cycle;
+  }
+  return population<G>{ G{ d0 }, G{ d1 } };
+}
+
+/**
+ * `edge_xover` is edge crossover (a.k.a. edge recombination) recombination.
+ *
+ * @tparam Some `G` specialization.
+ * @param g0 First parent.
+ * @param g1 Secong parent.
+ * @returns Population containing one offspring genotype.
+ *
+ * @note Time complexity is linear in genotype length.
+ *
+ * Example:
+ * @include permutation_xover.cc
+ *
+ * Result (might be different due to randomness):
+ * @verbinclude permutation_xover.out
+ */
+template<typename G>
+requires permutation_chromosome<G> population<G>
+edge_xover(const G& g0, const G& g1)
+{
+  using type = typename G::gene_t;
+  const std::size_t n = G::size();
+  // Edge table: at most four distinct neighbors for each element, common edges
+  // (present in both parents) are marked.
+  std::array<std::array<type, 4>, G::size()> neighbors{};
+  std::array<std::array<bool, 4>, G::size()> common{};
+  std::array<std::uint8_t, G::size()> count{};
+  const auto add = [&](type x, type y) {
+    const auto l = detail::locus<G>(x);
+    for (std::uint8_t k = 0; k < count[l]; ++k) {
+      if (neighbors[l][k] == y) {
+        common[l][k] = true;
+        return;
+      }
+    }
+    neighbors[l][count[l]++] = y;
+  };
+  for (const auto& c : { std::cref(g0.data()), std::cref(g1.data()) }) {
+    for (std::size_t i = 0; n > 1 && i < n; ++i) {
+      add(c.get()[i], c.get()[(i + 1) % n]);
+      add(c.get()[(i + 1) % n], c.get()[i]);
+    }
+  }
+  const auto remove = [&](type x, type y) {
+    const auto l = detail::locus<G>(x);
+    for (std::uint8_t k = 0; k < count[l]; ++k) {
+      if (neighbors[l][k] == y) {
+        --count[l];
+        neighbors[l][k] = neighbors[l][count[l]];
+        common[l][k] = common[l][count[l]];
+        return;
+      }
+    }
+  };
+  // Unused elements with positions allow for constant time random choice.
+  auto unused = g0.data();
+  std::array<std::size_t, G::size()> where{};
+  for (std::size_t i = 0; i < n; ++i) {
+    where[detail::locus<G>(unused[i])] = i;
+  }
+  std::size_t unused_sz = n;
+  const auto take = [&](type x) {
+    const auto i = where[detail::locus<G>(x)];
+    unused[i] = unused[--unused_sz];
+    where[detail::locus<G>(unused[i])] = i;
+  };
+
+  typename G::chain_t res{};
+  type x = unused[random_U<std::size_t>(0, n - 1)];
+  for (std::size_t i = 0;; x = res[i]) {
+    res[i++] = x;
+    take(x);
+    const auto l = detail::locus<G>(x);
+    for (std::uint8_t k = 0; k < count[l]; ++k) {
+      remove(neighbors[l][k], x);
+    }
+    if (i == n) {
+      break;
+    }
+    std::array<type, 4> candidates{};
+    std::size_t candidates_sz = 0;
+    bool common_found = false;
+    std::size_t best = std::numeric_limits<std::size_t>::max();
+    for (std::uint8_t k = 0; k < count[l]; ++k) {
+      const auto y = neighbors[l][k];
+      const std::size_t sz = count[detail::locus<G>(y)];
+      if (common[l][k] && !common_found) {
+        common_found = true;
+        candidates_sz = 0;
+      }
+      if (common_found && !common[l][k]) {
+        continue;
+      }
+      if (!common_found && sz > best) {
+        continue;
+      }
+      if (!common_found && sz < best) {
+        best = sz;
+        candidates_sz = 0;
+      }
+      candidates[candidates_sz++] = y;
+    }
+    res[i] = candidates_sz
+               ? candidates[random_U<std::size_t>(0, candidates_sz - 1)]
+               : unused[random_U<std::size_t>(0, unused_sz - 1)];
+  }
+  return population<G>{ G{ res } };
+}
+
+////////////////////////////////////////////////////
+// Test functions for floating-point optimization //
+////////////////////////////////////////////////////
+
+/**
+ * `test_functions` contains mechanisms for floating-point test functions.
+ */
+namespace test_functions {
+
+/**
+ * `test_functions::point` is point in N-dimensional space.
+ *
+ * @tparam T Floating-point type.
+ * @tparam N Space dimension.
+ */
+template<std::floating_point T, std::size_t N>
+using point = std::array<T, N>;
+
+/**
+ * `test_functions::distance` returns distance between two points.
+ *
+ * @tparam T Floating-point type.
+ * @tparam N Space dimension.
+ * @param p0 First point.
+ * @param p1 Second point.
+ * @returns Distance between `p0` and `p1`.
+ */
+template<std::floating_point T, std::size_t N>
+T
+distance(const point<T, N>& p0, const point<T, N>& p1)
+{
+  T res = .0;
+  for (std::size_t i = 0; i < N; ++i) {
+    res += square(p0[i] - p1[i]);
+  }
+  return std::sqrt(res);
+}
+
+/**
+ * `test_functions::coordinates` converts 2D-point to `std::tuple` containing
+ * point coordinates.
+ *
+ * @tparam T Floating-point type.
+ * @param p 2D-point.
+ * @returns Corresponding tuple.
+ */
+template<std::floating_point T>
+std::tuple<T, T>
+coordinates(const point<T, 2>& p)
+{
+  return std::tuple<T, T>{ p[0], p[1] };
+}
+
+/**
+ * `test_functions::coordinates` converts 3D-point to `std::tuple` containing
+ * point coordinates.
+ *
+ * @tparam T Floating-point type.
+ * @param p 3D-point.
+ * @returns Corresponding tuple.
+ */
+template<std::floating_point T>
+std::tuple<T, T, T>
+coordinates(const point<T, 3>& p)
+{
+  return std::tuple<T, T, T>{ p[0], p[1], p[2] };
+}
+
+/**
+ * `test_functions::uniform_point` returns point in N-dimensional space, where
+ * each coordinate has the same value `v`.
+ *
+ * @tparam T Floating-point type.
+ * @tparam Space dimension.
+ * @param v Coordinate value.
+ * @returns Point in N-dimensional space.
+ */
+template<std::floating_point T, std::size_t N>
+constexpr point<T, N>
+uniform_point(T v)
+{
+  point<T, N> res{};
+  std::ranges::generate(res, [=]() -> T { return v; });
+  return res;
+}
+
+/**
+ * `test_functions::static_test_function` specifies compile-time form of
+ * floating-point test function, i.e. type `F` providing floating-point type
+ * `F::type`, space dimension `F::size()`, name `F::name`, domain
+ * `F::function_domain` (constant expression), point minimizing the function
+ * `F::p_min()` and function value `F::value(p)` as static members. Optionally,
+ * `F::batch` provides batch kernel (cf. `test_function::batch_function`).
+ *
+ * @note Since `F::function_domain` is a constant expression, its address can
+ * be used as template argument of `g_floating_point`.
+ *
+ * Example:
+ * @include static_test_function.cc
+ *
+ * Result (might be different due to randomness):
+ * @verbinclude static_test_function.out
+ */
+template<typename F>
+concept static_test_function =
+  std::floating_point<typename F::type> &&
+  requires(const point<typename F::type, F::size()>& p)
+{
+  {
+    F::name
+    } -> std::convertible_to<std::string>;
+  {
+    F::function_domain
+    } -> std::convertible_to<domain<typename F::type, F::size()>>;
+  {
+    F::p_min()
+    } -> std::convertible_to<point<typename F::type, F::size()>>;
+  {
+    F::value(p)
+    } -> std::convertible_to<typename F::type>;
+};
+
+/**
+ * `test_functions::test_function` is floating-point test function.
+ *
+ * @tparam T Floating-point type.
+ * @tparam N Space dimension.
+ *
+ * @note `test_function` is type-erased wrapper; cf. `static_test_function`
+ * for compile-time form.
+ */
+template<std::floating_point T, std::size_t N>
+class test_function
+{
+public:
+  /**
+   * `test_functions::test_function::function` is underlying test function
+   * type.
+   */
+  using function = std::function<T(const point<T, N>&)>;
+
+  /**
+   * `test_functions::test_function::domain_fn` is test function domain.
+   */
+  using domain_fn = std::function<domain<T, N>()>;
+
+  /**
+   * `test_functions::test_function::point_fn` is solution generating function
+   * type.
+   */
+  using point_fn = std::function<point<T, N>()>;
+
+  /**
+   * `test_functions::test_function::batch_function` is underlying batch
+   * kernel type. Kernel invoked with arguments `x`, `n`, `ld` and `res` stores
+   * test function values at `n` points (at most `block_sz`) in `res`, where
+   * coordinate `j` of point `i` is `x[j * ld + i]`.
+   */
+  using batch_function =
+    std::function<void(const T*, std::size_t, std::size_t, T*)>;
+
+  /**
+   * `test_functions::test_function::block_sz` is maximal number of points
+   * passed to batch kernel at once.
+   */
+  static constexpr std::size_t block_sz = 64;
+
+public:
+  /**
+   * `test_functions::test_function::test_function` creates test function.
+   *
+   * @param name Test function name.
+   * @param fn The test function representation.
+   * @param d The test function domain.
+   * @param p_min Function generating solution minimizing the test function.
+   */
+  test_function(const std::string& name,
+                const function& fn,
+                const domain_fn& d,
+                const point_fn& p_min)
+    : name_{ name }
+    , fn_{ fn }
+    , d_{ d }
+    , p_min_{ p_min }
+  {
+  }
+
+  /**
+   * `test_functions::test_function::test_function` creates test function
+   * from its compile-time form.
+   *
+   * @tparam F Compile-time form of test function.
+   *
+   * Example:
+   * @include static_test_function.cc
+   *
+   * Result (might be different due to randomness):
+   * @verbinclude static_test_function.out
+   */
+  template<typename F>
+  requires static_test_function<F> && std::same_as<typename F::type, T> &&
+    (F::size() == N)
+  explicit test_function(F)
+    : name_{ F::name }
+    , fn_{ &F::value }
+    , d_{ []() { return F::function_domain; } }
+    , p_min_{ &F::p_min }
+  {
+    if constexpr (requires(const T* x, T* res) { F::batch(x, 0, 0, res); }) {
+      bfn_ = &F::batch;
+    }
+  }
+
+  /**
+   * `test_functions::test_function::test_function` creates test function
+   * with batch kernel.
+   *
+   * @param name Test function name.
+   * @param fn The test function representation.
+   * @param bfn The test function batch kernel (cf. `batch_function`).
+   * @param d The test function domain.
+   * @param p_min Function generating solution minimizing the test function.
+   */
+  test_function(const std::string& name,
+                const function& fn,
+                const batch_function& bfn,
+                const domain_fn& d,
+                const point_fn& p_min)
+    : name_{ name }
+    , fn_{ fn }
+    , bfn_{ bfn }
+    , d_{ d }
+    , p_min_{ p_min }
+  {
+  }
+
+  /**
+   * `test_functions::test_function::name` returns test function name.
+   *
+   * @returns Name of the test function.
+   */
+  std::string name() const { return name_; }
+
+  /**
+   * `test_functions::test_function::operator()` returns test function value
+   * at point `p`.
+   *
+   * @param p Point.
+   * @returns Test function value at point `p`.
+   */
+  T operator()(const point<T, N>& p) const { return fn_(p); }
+
+  /**
+   * `test_functions::test_function::batch` stores test function values at
+   * points `ps` in `res`.
+   *
+   * @param ps Points.
+   * @param res Test function values (of the same size as `ps`).
+   *
+   * @throws std::invalid_argument Exception is raised if sizes of `ps` and
+   * `res` differ.
+   *
+   * @note Points are transposed block by block to coordinate-wise layout and
+   * passed to batch kernel; without batch kernel the test function is called
+   * for each point.
+   *
+   * Example:
+   * @include test_function_batch.cc
+   *
+   * Result (might be different due to randomness):
+   * @verbinclude test_function_batch.out
+   */
+  void batch(std::span<const point<T, N>> ps, std::span<T> res) const
+  {
+    if (ps.size() != res.size()) {
+      throw std::invalid_argument{ "inconsistent sizes" };
+    }
+    if (!bfn_) {
+      std::ranges::transform(ps, std::begin(res), fn_);
+      return;
+    }
+    std::vector<T> x(N * std::min(block_sz, ps.size()));
+    for (std::size_t b = 0; b < ps.size(); b += block_sz) {
+      const std::size_t n = std::min(block_sz, ps.size() - b);
+      for (std::size_t i = 0; i < n; ++i) {
+        for (std::size_t j = 0; j < N; ++j) {
+          x[j * n + i] = ps[b + i][j];
+        }
+      }
+      bfn_(x.data(), n, n, res.data() + b);
+    }
+  }
+
+  /**
+   * `test_functions::test_function::batch` stores test function values at
+   * points given coordinate-wise in `xs` in `res`, i.e. coordinate `j` of
+   * point `i` is `xs[j * res.size() + i]`.
+   *
+   * @param xs Coordinates of points.
+   * @param res Test function values.
+   *
+   * @throws std::invalid_argument Exception is raised if size of `xs` is not
+   * equal to `N * res.size()`.
+   *
+   * Example:
+   * @include test_function_batch.cc
+   *
+   * Result (might be different due to randomness):
+   * @verbinclude test_function_batch.out
+   */
+  void batch(std::span<const T> xs, std::span<T> res) const
+  {
+    const std::size_t sz = res.size();
+    if (xs.size() != N * sz) {
+      throw std::invalid_argument{ "inconsistent sizes" };
+    }
+    if (!bfn_) {
+      point<T, N> p{};
+      for (std::size_t i = 0; i < sz; ++i) {
+        for (std::size_t j = 0; j < N; ++j) {
+          p[j] = xs[j * sz + i];
+        }
+        res[i] = fn_(p);
+      }
+      return;
+    }
+    for (std::size_t b = 0; b < sz; b += block_sz) {
+      bfn_(xs.data() + b, std::min(block_sz, sz - b), sz, res.data() + b);
+    }
+  }
+
+  /**
+   * `test_functions::test_function::function_domain` returns test function
+   * domain.
+   *
+   * @returns Test function domain.
+   */
+  domain<T, N> function_domain() const { return d_(); }
+
+  /**
+   * `test_functions::test_function::p_min` returns point minimizing test
+   * function over its domain.
+   *
+   * @returns Point minimizing test function over its domain.
+   */
+  point<T, N> p_min() const { return p_min_(); }
+
+private:
+  std::string name_;
+  function fn_;
+  batch_function bfn_{};
+  domain_fn d_;
+  point_fn p_min_;
+};
+
+namespace compile_time {
+
+/**
+ * `test_functions::compile_time::Ackley` is compile-time form of Ackley test
+ * function (cf. `test_functions::Ackley`).
+ *
+ * @tparam T Floating-point type.
+ * @tparam N Space dimension.
+ */
+template<std::floating_point T, std::size_t N>
+struct Ackley
+{
+  using type = T;
+  static constexpr std::size_t size() { return N; }
+  static constexpr const char* name = "Ackley";
+  static constexpr domain<T, N> function_domain =
+    uniform_domain<T, N>(-35., 35.);
+  static constexpr point<T, N> p_min() { return uniform_point<T, N>(0.); }
+
+  static T value(const point<T, N>& p)
+  {
+    T s0 = 0.;
+    T s1 = 0.;
+    for (auto x : p) {
+      s0 += square(x);
+      s1 += std::cos(2 * pi<T> * x);
+    }
+    return -20. * std::exp(-.02 * std::sqrt(s0) / std::sqrt(N)) -
+           std::exp(s1 / N) + 20. + e<T>;
+  }
+
+  static void batch(const T* x, std::size_t n, std::size_t ld, T* res)
+  {
+    std::array<T, test_function<T, N>::block_sz> s0{};
+    std::array<T, test_function<T, N>::block_sz> s1{};
+    for (std::size_t j = 0; j < N; ++j) {
+      const T* xj = x + j * ld;
+      for (std::size_t i = 0; i < n; ++i) {
+        s0[i] += square(xj[i]);
+        s1[i] += std::cos(2 * pi<T> * xj[i]);
+      }
+    }
+    for (std::size_t i = 0; i < n; ++i) {
+      res[i] = -20. * std::exp(-.02 * std::sqrt(s0[i]) / std::sqrt(N)) -
+               std::exp(s1[i] / N) + 20. + e<T>;
+    }
+  }
+};
+
+/**
+ * `test_functions::compile_time::Alpine` is compile-time form of Alpine test
+ * function (cf. `test_functions::Alpine`).
+ *
+ * @tparam T Floating-point type.
+ * @tparam N Space dimension.
+ */
+template<std::floating_point T, std::size_t N>
+struct Alpine
+{
+  using type = T;
+  static constexpr std::size_t size() { return N; }
+  static constexpr const char* name = "Alpine";
+  static constexpr domain<T, N> function_domain =
+    uniform_domain<T, N>(-10., 10.);
+  static constexpr point<T, N> p_min() { return uniform_point<T, N>(0.); }
+
+  static T value(const point<T, N>& p)
+  {
+    return std::transform_reduce(
+      std::begin(p), std::end(p), T{ 0. }, std::plus<T>{}, [](auto x) {
+        return std::fabs(x * std::sin(x) + .1 * x);
+      });
+  }
+
+  static void batch(const T* x, std::size_t n, std::size_t ld, T* res)
+  {
+    std::fill_n(res, n, T{ 0. });
+    for (std::size_t j = 0; j < N; ++j) {
+      const T* xj = x + j * ld;
+      for (std::size_t i = 0; i < n; ++i) {
+        res[i] += std::fabs(xj[i] * std::sin(xj[i]) + .1 * xj[i]);
+      }
+    }
+  }
+};
+
+/**
+ * `test_functions::compile_time::Aluffi_Pentini` is compile-time form of
+ * Aluffi-Pentini test function (cf. `test_functions::Aluffi_Pentini`).
  *
- * @tparam G Some `genotype` specialization.
- * @param p Gene mutation probability.
- * @returns Bit-flipping mutation operator.
+ * @tparam T Floating-point type.
+ *
+ * @note `p_min` is not `constexpr` (it is computed with mathematical
+ * functions).
  */
-template<typename G>
-requires binary_chromosome<G>
-auto
-bit_flipping(probability p)
+template<std::floating_point T>
+struct Aluffi_Pentini
 {
-  return [=](const G& g) -> population<G> {
-    G res{ g };
-    for (std::size_t i = 0; i < G::size(); ++i) {
-      if (success(p)) {
-        res.value(i, !res.value(i));
-      }
-    }
-    return population<G>{ res };
-  };
-}
+  using type = T;
+  static constexpr std::size_t size() { return 2; }
+  static constexpr const char* name = "Aluffi-Pentini";
+  static constexpr domain<T, 2> function_domain =
+    uniform_domain<T, 2>(-10., 10.);
+
+  static point<T, 2> p_min()
+  {
+    return point<T, 2>{ [q = 0.1](int k) -> T {
+                         return 2. * std::sqrt(3.) *
+                                std::cos(
+                                  std::acos(-3. * std::sqrt(3.) * q / 2.) / 3. -
+                                  2. * std::numbers::pi_v<T> * k / 3.) /
+                                3.;
+                       }(2),
+                        0. };
+  }
+
+  static T value(const point<T, 2>& p)
+  {
+    const auto [x, y] = coordinates(p);
+    return ((.25 * x * x - .5) * x + .1) * x + 0.5 * y * y;
+  }
+};
 
 /**
- * `arithmetic_recombination` is arithmetic recombination.
- *
- * @tparam Some `G` specialization.
- * @param g0 First parent.
- * @param g1 Secong parent.
- * @returns Population containing one offspring genotype.
- *
- * Example:
- * @include self_adaptive.cc
- *
- * Result (might be different due to randomness):
- * @verbinclude self_adaptive.out
+ * `test_functions::compile_time::Booth` is compile-time form of Booth test
+ * function (cf. `test_functions::Booth`).
  *
- * @note Evolution result is saved in separate file (not included).
+ * @tparam T Floating-point type.
  */
-template<typename G>
-requires floating_point_chromosome<G> population<G>
-arithmetic_recombination(const G& g0, const G& g1)
+template<std::floating_point T>
+struct Booth
 {
-  G res{};
-  for (std::size_t i = 0; i < G::size(); ++i) {
-    res.value(i, std::midpoint(g0.value(i), g1.value(i)));
+  using type = T;
+  static constexpr std::size_t size() { return 2; }
+  static constexpr const char* name = "Booth";
+  static constexpr domain<T, 2> function_domain =
+    uniform_domain<T, 2>(-10., 10.);
+  static constexpr point<T, 2> p_min() { return point<T, 2>{ 1., 3. }; }
+
+  static T value(const point<T, 2>& p)
+  {
+    const auto [x, y] = coordinates(p);
+    return square(x + 2. * y - 7.) + square(2. * x + y - 5.);
   }
-  return population<G>{ res };
-}
+};
 
 /**
- * `single_arithmetic_recombination` is single arithmetic recombination.
+ * `test_functions::compile_time::Colville` is compile-time form of Colville
+ * test function (cf. `test_functions::Colville`).
  *
- * @tparam Some `G` specialization.
- * @param g0 First parent.
- * @param g1 Secong parent.
- * @returns Population containing two offspring genotypes.
- *
- * Example:
- * @include recombination.cc
- *
- * Result (might be different due to randomness):
- * @verbinclude recombination.out
+ * @tparam T Floating-point type.
  */
-template<typename G>
-requires floating_point_chromosome<G> population<G>
-single_arithmetic_recombination(const G& g0, const G& g1)
+template<std::floating_point T>
+struct Colville
 {
-  G res0{ g0 };
-  G res1{ g1 };
-  const auto cp = random_U<std::size_t>(0, G::size() - 1);
-  const auto mid = std::midpoint(res0.value(cp), res1.value(cp));
-  res0.value(cp, mid);
-  res1.value(cp, mid);
-  return population<G>{ res0, res1 };
-}
+  using type = T;
+  static constexpr std::size_t size() { return 4; }
+  static constexpr const char* name = "Colville";
+  static constexpr domain<T, 4> function_domain =
+    uniform_domain<T, 4>(-10., 10.);
+  static constexpr point<T, 4> p_min() { return uniform_point<T, 4>(1.); }
+
+  static T value(const point<T, 4>& p)
+  {
+    return 100. * square(p[0] - square(p[1])) + square(1. - p[0]) +
+           90. * square(p[3] - p[2] * p[2]) + square(1. - p[2]) +
+           10.1 * square(p[1] - 1.) + square(p[3] - 1.) +
+           19.8 * (p[1] - 1.) * (p[3] - 1.);
+  }
+};
 
 /**
- * `one_point_xover` is one-point crossover recombination.
- *
- * @tparam Some `G` specialization.
- * @param g0 First parent.
- * @param g1 Secong parent.
- * @returns Population containing two offspring genotypes.
+ * `test_functions::compile_time::Easom` is compile-time form of Easom test
+ * function (cf. `test_functions::Easom`).
  *
- * Example:
- * @include recombination.cc
- *
- * Result (might be different due to randomness):
- * @verbinclude recombination.out
+ * @tparam T Floating-point type.
  */
-template<typename G>
-requires floating_point_chromosome<G> || integer_chromosome<G> ||
-  binary_chromosome<G>
-    population<G>
-    one_point_xover(const G& g0, const G& g1)
+template<std::floating_point T>
+struct Easom
 {
-  auto d0 = g0.data();
-  auto d1 = g1.data();
-  const std::size_t n = G::size();
-  const auto cp = random_U<std::size_t>(0, n - 1);
-  for (std::size_t i = cp; i < n; ++i) {
-    std::swap(d0[i], d1[i]);
+  using type = T;
+  static constexpr std::size_t size() { return 2; }
+  static constexpr const char* name = "Easom";
+  static constexpr domain<T, 2> function_domain =
+    uniform_domain<T, 2>(-100., 100);
+  static constexpr point<T, 2> p_min() { return uniform_point<T, 2>(pi<T>); }
+
+  static T value(const point<T, 2>& p)
+  {
+    const auto [x, y] = coordinates(p);
+    return -std::cos(x) * std::cos(y) *
+           std::exp(-square(x - pi<T>) - square(y - pi<T>));
   }
-  return population<G>{ G{ d0 }, G{ d1 } };
-}
+};
 
 /**
- * `cut_n_crossfill` is cut-and-crossfill recombination.
- *
- * @tparam Some `G` specialization.
- * @param g0 First parent.
- * @param g1 Secong parent.
- * @returns Population containing two offspring genotypes.
- *
- * Example:
- * @include variation.cc
+ * `test_functions::compile_time::exponential` is compile-time form of
+ * exponential test function (cf. `test_functions::exponential`).
  *
- * Result (might be different due to randomness):
- * @verbinclude variation.out
+ * @tparam T Floating-point type.
+ * @tparam N Space dimension.
  */
-template<typename G>
-requires permutation_chromosome<G> population<G>
-cut_n_crossfill(const G& g0, const G& g1)
+template<std::floating_point T, std::size_t N>
+struct exponential
 {
-  const auto f = [cp = random_U<std::size_t>(1, G::size() - 1)](const G& g,
-                                                                auto d) {
-    auto it = std::begin(d);
-    std::advance(it, cp);
-    for (auto x : g) {
-      if (std::find(std::begin(d), it, x) == it) {
-        *it++ = x;
+  using type = T;
+  static constexpr std::size_t size() { return N; }
+  static constexpr const char* name = "exponential";
+  static constexpr domain<T, N> function_domain = uniform_domain<T, N>(-1., 1.);
+  static constexpr point<T, N> p_min() { return uniform_point<T, N>(0.); }
+
+  static T value(const point<T, N>& p)
+  {
+    return -std::exp(
+      -.5 * std::transform_reduce(
+              std::begin(p), std::end(p), T{ 0. }, std::plus<T>{}, square<T>));
+  }
+
+  static void batch(const T* x, std::size_t n, std::size_t ld, T* res)
+  {
+    std::fill_n(res, n, T{ 0. });
+    for (std::size_t j = 0; j < N; ++j) {
+      const T* xj = x + j * ld;
+      for (std::size_t i = 0; i < n; ++i) {
+        res[i] += square(xj[i]);
       }
     }
-    assert(it == std::end(d));
-    return d;
-  };
-  return population<G>{ G{ f(g1, g0.data()) }, G{ f(g0, g1.data()) } };
-}
+    for (std::size_t i = 0; i < n; ++i) {
+      res[i] = -std::exp(-.5 * res[i]);
+    }
+  }
+};
 
-////////////////////////////////////////////////////
-// Test functions for floating-point optimization //
-////////////////////////////////////////////////////
+/**
+ * `test_functions::compile_time::Goldstein_Price` is compile-time form of
+ * Goldstein-Price test function (cf. `test_functions::Goldstein_Price`).
+ *
+ * @tparam T Floating-point type.
+ */
+template<std::floating_point T>
+struct Goldstein_Price
+{
+  using type = T;
+  static constexpr std::size_t size() { return 2; }
+  static constexpr const char* name = "Goldstein-Price";
+  static constexpr domain<T, 2> function_domain = uniform_domain<T, 2>(-2., 2.);
+  static constexpr point<T, 2> p_min() { return point<T, 2>{ 0., -1. }; }
+
+  static T value(const point<T, 2>& p)
+  {
+    const auto [x, y] = coordinates(p);
+    const auto [x2, y2] = std::tuple<T, T>{ x * x, y * y };
+    const auto xy = x * y;
+    return (1. + square(x + y + 1.) *
+                   (19. - 14. * x + 3. * x2 - 14. * y + 6. * xy + 3. * y2)) *
+           (30. + square(2. * x - 3. * y) *
+                    (18. - 32. * x + 12. * x2 + 48. * y - 36. * xy + 27. * y2));
+  }
+};
 
 /**
- * `test_functions` contains mechanisms for floating-point test functions.
+ * `test_functions::compile_time::Hosaki` is compile-time form of Hosaki test
+ * function (cf. `test_functions::Hosaki`).
+ *
+ * @tparam T Floating-point type.
  */
-namespace test_functions {
+template<std::floating_point T>
+struct Hosaki
+{
+  using type = T;
+  static constexpr std::size_t size() { return 2; }
+  static constexpr const char* name = "Hosaki";
+  static constexpr domain<T, 2> function_domain =
+    uniform_domain<T, 2>(-10., 10.);
+  static constexpr point<T, 2> p_min() { return point<T, 2>{ 4., 2. }; }
+
+  static T value(const point<T, 2>& p)
+  {
+    const auto [x, y] = coordinates(p);
+    return (1. + x * (-8. + x * (7. + x * (-7. / 3. + x / 4.)))) * y * y *
+           std::exp(-y);
+  }
+};
 
 /**
- * `test_functions::point` is point in N-dimensional space.
+ * `test_functions::compile_time::Leon` is compile-time form of Leon test
+ * function (cf. `test_functions::Leon`).
  *
  * @tparam T Floating-point type.
- * @tparam N Space dimension.
  */
-template<std::floating_point T, std::size_t N>
-using point = std::array<T, N>;
+template<std::floating_point T>
+struct Leon
+{
+  using type = T;
+  static constexpr std::size_t size() { return 2; }
+  static constexpr const char* name = "Leon";
+  static constexpr domain<T, 2> function_domain =
+    uniform_domain<T, 2>(-1.2, 1.2);
+  static constexpr point<T, 2> p_min() { return uniform_point<T, 2>(1.); }
+
+  static T value(const point<T, 2>& p)
+  {
+    const auto [x, y] = coordinates(p);
+    return 100. * square(y - x * x) + square(1. - x);
+  }
+};
 
 /**
- * `test_functions::distance` returns distance between two points.
+ * `test_functions::compile_time::Matyas` is compile-time form of Matyas test
+ * function (cf. `test_functions::Matyas`).
  *
  * @tparam T Floating-point type.
- * @tparam N Space dimension.
- * @param p0 First point.
- * @param p1 Second point.
- * @returns Distance between `p0` and `p1`.
  */
-template<std::floating_point T, std::size_t N>
-T
-distance(const point<T, N>& p0, const point<T, N>& p1)
+template<std::floating_point T>
+struct Matyas
 {
-  T res = .0;
-  for (std::size_t i = 0; i < N; ++i) {
-    res += square(p0[i] - p1[i]);
+  using type = T;
+  static constexpr std::size_t size() { return 2; }
+  static constexpr const char* name = "Matyas";
+  static constexpr domain<T, 2> function_domain =
+    uniform_domain<T, 2>(-10., 10.);
+  static constexpr point<T, 2> p_min() { return uniform_point<T, 2>(0.); }
+
+  static T value(const point<T, 2>& p)
+  {
+    const auto [x, y] = coordinates(p);
+    return .26 * (x * x + y * y) - .48 * x * y;
   }
-  return std::sqrt(res);
-}
+};
 
 /**
- * `test_functions::coordinates` converts 2D-point to `std::tuple` containing
- * point coordinates.
+ * `test_functions::compile_time::Mexican_hat` is compile-time form of Mexican
+ * hat test function (cf. `test_functions::Mexican_hat`).
  *
  * @tparam T Floating-point type.
- * @param p 2D-point.
- * @returns Corresponding tuple.
  */
 template<std::floating_point T>
-std::tuple<T, T>
-coordinates(const point<T, 2>& p)
+struct Mexican_hat
 {
-  return std::tuple<T, T>{ p[0], p[1] };
-}
+  using type = T;
+  static constexpr std::size_t size() { return 2; }
+  static constexpr const char* name = "Mexican hat";
+  static constexpr domain<T, 2> function_domain =
+    uniform_domain<T, 2>(-10., 10.);
+  static constexpr point<T, 2> p_min() { return uniform_point<T, 2>(4.); }
+
+  static T value(const point<T, 2>& p)
+  {
+    const auto [x, y] = coordinates(p);
+    const auto f = [&, x = x, y = y]() {
+      return .1 + std::sqrt(square(x - 4.) + square(y - 4.));
+    };
+    return -20. * std::sin(f()) / f();
+  }
+};
 
 /**
- * `test_functions::coordinates` converts 3D-point to `std::tuple` containing
- * point coordinates.
+ * `test_functions::compile_time::Miele_Cantrell` is compile-time form of
+ * Miele-Cantrell test function (cf. `test_functions::Miele_Cantrell`).
  *
  * @tparam T Floating-point type.
- * @param p 3D-point.
- * @returns Corresponding tuple.
  */
 template<std::floating_point T>
-std::tuple<T, T, T>
-coordinates(const point<T, 3>& p)
+struct Miele_Cantrell
 {
-  return std::tuple<T, T, T>{ p[0], p[1], p[2] };
-}
+  using type = T;
+  static constexpr std::size_t size() { return 4; }
+  static constexpr const char* name = "Miele-Cantrell";
+  static constexpr domain<T, 4> function_domain = uniform_domain<T, 4>(-1., 1);
+  static constexpr point<T, 4> p_min() { return point<T, 4>{ 0., 1., 1., 1. }; }
+
+  static T value(const point<T, 4>& p)
+  {
+    return std::pow(std::exp(-p[0]) - p[1], 4.) +
+           100. * std::pow(p[1] - p[2], 6.) +
+           std::pow(std::tan(p[2] - p[3]), 4.) + std::pow(p[0], 8.);
+  }
+};
 
 /**
- * `test_functions::uniform_point` returns point in N-dimensional space, where
- * each coordinate has the same value `v`.
+ * `test_functions::compile_time::Rosenbrock` is compile-time form of
+ * Rosenbrock test function (cf. `test_functions::Rosenbrock`).
  *
  * @tparam T Floating-point type.
- * @tparam Space dimension.
- * @param v Coordinate value.
- * @returns Point in N-dimensional space.
+ * @tparam N Space dimension.
  */
 template<std::floating_point T, std::size_t N>
-point<T, N>
-uniform_point(T v)
+struct Rosenbrock
 {
-  point<T, N> res{};
-  std::ranges::generate(res, [=]() -> T { return v; });
-  return res;
-}
+  using type = T;
+  static constexpr std::size_t size() { return N; }
+  static constexpr const char* name = "Rosenbrock";
+  static constexpr domain<T, N> function_domain =
+    uniform_domain<T, N>(-30., 30.);
+  static constexpr point<T, N> p_min() { return uniform_point<T, N>(1.); }
+
+  static T value(const point<T, N>& p)
+  {
+    T res = 0.;
+    for (std::size_t i = 0; i < N - 1; ++i) {
+      res += 100. * square(p[i + 1] - square(p[i])) + square(p[i] - 1.);
+    }
+    return res;
+  }
+
+  static void batch(const T* x, std::size_t n, std::size_t ld, T* res)
+  {
+    std::fill_n(res, n, T{ 0. });
+    for (std::size_t j = 0; j + 1 < N; ++j) {
+      const T* xj = x + j * ld;
+      const T* xk = xj + ld;
+      for (std::size_t i = 0; i < n; ++i) {
+        res[i] += 100. * square(xk[i] - square(xj[i])) + square(xj[i] - 1.);
+      }
+    }
+  }
+};
 
 /**
- * `test_functions::test_function` is floating-point test function.
+ * `test_functions::compile_time::Schwefel` is compile-time form of Schwefel
+ * test function (cf. `test_functions::Schwefel`).
  *
  * @tparam T Floating-point type.
  * @tparam N Space dimension.
  */
 template<std::floating_point T, std::size_t N>
-class test_function
+struct Schwefel
 {
-public:
-  /**
-   * `test_functions::test_function::function` is underlying test function
-   * type.
-   */
-  using function = std::function<T(const point<T, N>&)>;
-
-  /**
-   * `test_functions::test_function::domain_fn` is test function domain.
-   */
-  using domain_fn = std::function<domain<T, N>()>;
-
-  /**
-   * `test_functions::test_function::point_fn` is solution generating function
-   * type.
-   */
-  using point_fn = std::function<point<T, N>()>;
+  using type = T;
+  static constexpr std::size_t size() { return N; }
+  static constexpr const char* name = "Schwefel";
+  static constexpr domain<T, N> function_domain =
+    uniform_domain<T, N>(-100., 100.);
+  static constexpr point<T, N> p_min() { return uniform_point<T, N>(0.); }
 
-public:
-  /**
-   * `test_functions::test_function::test_function` creates test function.
-   *
-   * @param name Test function name.
-   * @param fn The test function representation.
-   * @param d The test function domain.
-   * @param p_min Function generating solution minimizing the test function.
-   */
-  test_function(const std::string& name,
-                const function& fn,
-                const domain_fn& d,
-                const point_fn& p_min)
-    : name_{ name }
-    , fn_{ fn }
-    , d_{ d }
-    , p_min_{ p_min }
+  static T value(const point<T, N>& p)
   {
+    T res = 0.;
+    for (T sum = 0.; auto x : p) {
+      res += square(sum += x);
+    }
+    return res;
   }
 
-  /**
-   * `test_functions::test_function::name` returns test function name.
-   *
-   * @returns Name of the test function.
-   */
-  std::string name() const { return name_; }
-
-  /**
-   * `test_functions::test_function::operator()` returns test function value
-   * at point `p`.
-   *
-   * @param p Point.
-   * @returns Test function value at point `p`.
-   */
-  T operator()(const point<T, N>& p) const { return fn_(p); }
+  static void batch(const T* x, std::size_t n, std::size_t ld, T* res)
+  {
+    std::array<T, test_function<T, N>::block_sz> sum{};
+    std::fill_n(res, n, T{ 0. });
+    for (std::size_t j = 0; j < N; ++j) {
+      const T* xj = x + j * ld;
+      for (std::size_t i = 0; i < n; ++i) {
+        res[i] += square(sum[i] += xj[i]);
+      }
+    }
+  }
+};
 
-  /**
-   * `test_functions::test_function::function_domain` returns test function
-   * domain.
-   *
-   * @returns Test function domain.
-   */
-  domain<T, N> function_domain() const { return d_(); }
+/**
+ * `test_functions::compile_time::sphere` is compile-time form of sphere test
+ * function (cf. `test_functions::sphere`).
+ *
+ * @tparam T Floating-point type.
+ * @tparam N Space dimension.
+ */
+template<std::floating_point T, std::size_t N>
+struct sphere
+{
+  using type = T;
+  static constexpr std::size_t size() { return N; }
+  static constexpr const char* name = "sphere";
+  static constexpr domain<T, N> function_domain = uniform_domain<T, N>(0., 10.);
+  static constexpr point<T, N> p_min() { return uniform_point<T, N>(0.); }
 
-  /**
-   * `test_functions::test_function::p_min` returns point minimizing test
-   * function over its domain.
-   *
-   * @returns Point minimizing test function over its domain.
-   */
-  point<T, N> p_min() const { return p_min_(); }
+  static T value(const point<T, N>& p)
+  {
+    return std::transform_reduce(
+      std::begin(p), std::end(p), T{ 0. }, std::plus<T>{}, square<T>);
+  }
 
-private:
-  std::string name_;
-  function fn_;
-  domain_fn d_;
-  point_fn p_min_;
+  static void batch(const T* x, std::size_t n, std::size_t ld, T* res)
+  {
+    std::fill_n(res, n, T{ 0. });
+    for (std::size_t j = 0; j < N; ++j) {
+      const T* xj = x + j * ld;
+      for (std::size_t i = 0; i < n; ++i) {
+        res[i] += square(xj[i]);
+      }
+    }
+  }
 };
 
+} // namespace compile_time
+
 /**
  * `test_functions::Ackley` is Ackley test function.
  *
@@ -4478,21 +9877,7 @@ private:
  * \f]
  */
 template<std::floating_point T, std::size_t N>
-const test_function<T, N> Ackley{
-  "Ackley",
-  [](const point<T, N>& p) {
-    T s0 = 0.;
-    T s1 = 0.;
-    for (auto x : p) {
-      s0 += square(x);
-      s1 += std::cos(2 * pi<T> * x);
-    }
-    return -20. * std::exp(-.02 * std::sqrt(s0) / std::sqrt(N)) -
-           std::exp(s1 / N) + 20. + e<T>;
-  },
-  []() { return uniform_domain<T, N>(-35., 35.); },
-  []() { return uniform_point<T, N>(0.); }
-};
+const test_function<T, N> Ackley{ compile_time::Ackley<T, N>{} };
 
 /**
  * `test_functions::Alpine` is Alpine test function.
@@ -4503,17 +9888,7 @@ const test_function<T, N> Ackley{
  * \f]
  */
 template<std::floating_point T, std::size_t N>
-const test_function<T, N> Alpine{
-  "Alpine",
-  [](const point<T, N>& p) {
-    return std::transform_reduce(
-      std::begin(p), std::end(p), T{ 0. }, std::plus<T>{}, [](auto x) {
-        return std::fabs(x * std::sin(x) + .1 * x);
-      });
-  },
-  []() { return uniform_domain<T, N>(-10., 10.); },
-  []() { return uniform_point<T, N>(0.); }
-};
+const test_function<T, N> Alpine{ compile_time::Alpine<T, N>{} };
 
 /**
  * `test_functions::Aluffi_Pentini` is Aluffi-Pentini test function.
@@ -4525,24 +9900,7 @@ const test_function<T, N> Alpine{
  * \f]
  */
 template<std::floating_point T>
-const test_function<T, 2> Aluffi_Pentini{
-  "Aluffi-Pentini",
-  [](const point<T, 2>& p) {
-    const auto [x, y] = coordinates(p);
-    return ((.25 * x * x - .5) * x + .1) * x + 0.5 * y * y;
-  },
-  []() { return uniform_domain<T, 2>(-10., 10.); },
-  []() {
-    return point<T, 2>{ [q = 0.1](int k) -> T {
-                         return 2. * std::sqrt(3.) *
-                                std::cos(
-                                  std::acos(-3. * std::sqrt(3.) * q / 2.) / 3. -
-                                  2. * std::numbers::pi_v<T> * k / 3.) /
-                                3.;
-                       }(2),
-                        0. };
-  }
-};
+const test_function<T, 2> Aluffi_Pentini{ compile_time::Aluffi_Pentini<T>{} };
 
 /**
  * `test_functions::Booth` is Booth test function.
@@ -4553,17 +9911,7 @@ const test_function<T, 2> Aluffi_Pentini{
  * \f]
  */
 template<std::floating_point T>
-const test_function<T, 2> Booth{
-  "Booth",
-  [](const point<T, 2>& p) {
-    const auto [x, y] = coordinates(p);
-    return square(x + 2. * y - 7.) + square(2. * x + y - 5.);
-  },
-  []() { return uniform_domain<T, 2>(-10., 10.); },
-  []() {
-    return point<T, 2>{ 1., 3. };
-  }
-};
+const test_function<T, 2> Booth{ compile_time::Booth<T>{} };
 
 /**
  * `test_functions::Colville` is Colville test function.
@@ -4578,17 +9926,7 @@ const test_function<T, 2> Booth{
  * \f}
  */
 template<std::floating_point T>
-const test_function<T, 4> Colville{
-  "Colville",
-  [](const point<T, 4>& p) {
-    return 100. * square(p[0] - square(p[1])) + square(1. - p[0]) +
-           90. * square(p[3] - p[2] * p[2]) + square(1. - p[2]) +
-           10.1 * square(p[1] - 1.) + square(p[3] - 1.) +
-           19.8 * (p[1] - 1.) * (p[3] - 1.);
-  },
-  []() { return uniform_domain<T, 4>(-10., 10.); },
-  []() { return uniform_point<T, 4>(1.); }
-};
+const test_function<T, 4> Colville{ compile_time::Colville<T>{} };
 
 /**
  * `test_functions::Easom` is Easom test function.
@@ -4600,16 +9938,7 @@ const test_function<T, 4> Colville{
  * \f]
  */
 template<std::floating_point T>
-const test_function<T, 2> Easom{
-  "Easom",
-  [](const point<T, 2>& p) {
-    const auto [x, y] = coordinates(p);
-    return -std::cos(x) * std::cos(y) *
-           std::exp(-square(x - pi<T>) - square(y - pi<T>));
-  },
-  []() { return uniform_domain<T, 2>(-100., 100); },
-  []() { return uniform_point<T, 2>(pi<T>); }
-};
+const test_function<T, 2> Easom{ compile_time::Easom<T>{} };
 
 /**
  * `test_functions::exponential` is exponential test function.
@@ -4620,16 +9949,7 @@ const test_function<T, 2> Easom{
  * \f]
  */
 template<std::floating_point T, std::size_t N>
-const test_function<T, N> exponential{
-  "exponential",
-  [](const point<T, N>& p) {
-    return -std::exp(
-      -.5 * std::transform_reduce(
-              std::begin(p), std::end(p), T{ 0. }, std::plus<T>{}, square<T>));
-  },
-  []() { return uniform_domain<T, N>(-1., 1.); },
-  []() { return uniform_point<T, N>(0.); }
-};
+const test_function<T, N> exponential{ compile_time::exponential<T, N>{} };
 
 /**
  * `test_functions::Goldstein_Price` is Goldstein-Price test function.
@@ -4645,22 +9965,7 @@ const test_function<T, N> exponential{
  * \f}
  */
 template<std::floating_point T>
-const test_function<T, 2> Goldstein_Price{
-  "Goldstein-Price",
-  [](const point<T, 2>& p) {
-    const auto [x, y] = coordinates(p);
-    const auto [x2, y2] = std::tuple<T, T>{ x * x, y * y };
-    const auto xy = x * y;
-    return (1. + square(x + y + 1.) *
-                   (19. - 14. * x + 3. * x2 - 14. * y + 6. * xy + 3. * y2)) *
-           (30. + square(2. * x - 3. * y) *
-                    (18. - 32. * x + 12. * x2 + 48. * y - 36. * xy + 27. * y2));
-  },
-  []() { return uniform_domain<T, 2>(-2., 2.); },
-  []() {
-    return point<T, 2>{ 0., -1. };
-  }
-};
+const test_function<T, 2> Goldstein_Price{ compile_time::Goldstein_Price<T>{} };
 
 /**
  * `test_functions::Hosaki` is Hosaki test function.
@@ -4672,18 +9977,7 @@ const test_function<T, 2> Goldstein_Price{
  * \f]
  */
 template<std::floating_point T>
-const test_function<T, 2> Hosaki{
-  "Hosaki",
-  [](const point<T, 2>& p) {
-    const auto [x, y] = coordinates(p);
-    return (1. + x * (-8. + x * (7. + x * (-7. / 3. + x / 4.)))) * y * y *
-           std::exp(-y);
-  },
-  []() { return uniform_domain<T, 2>(-10., 10.); },
-  []() {
-    return point<T, 2>{ 4., 2. };
-  }
-};
+const test_function<T, 2> Hosaki{ compile_time::Hosaki<T>{} };
 
 /**
  * `test_functions::Leon` is Leon test function.
@@ -4694,17 +9988,7 @@ const test_function<T, 2> Hosaki{
  * \f]
  */
 template<std::floating_point T>
-const test_function<T, 2> Leon{
-  "Leon",
-  [](const point<T, 2>& p) {
-    const auto [x, y] = coordinates(p);
-    return 100. * square(y - x * x) + square(1. - x);
-  },
-  []() { return uniform_domain<T, 2>(-1.2, 1.2); },
-  []() {
-    return point<T, 2>{ 1., 1. };
-  }
-};
+const test_function<T, 2> Leon{ compile_time::Leon<T>{} };
 
 /**
  * `test_functions::Matyas` is Matyas test function.
@@ -4715,15 +9999,7 @@ const test_function<T, 2> Leon{
  * \f]
  */
 template<std::floating_point T>
-const test_function<T, 2> Matyas{ "Matyas",
-                                  [](const point<T, 2>& p) {
-                                    const auto [x, y] = coordinates(p);
-                                    return .26 * (x * x + y * y) - .48 * x * y;
-                                  },
-                                  []() {
-                                    return uniform_domain<T, 2>(-10., 10.);
-                                  },
-                                  []() { return uniform_point<T, 2>(0.); } };
+const test_function<T, 2> Matyas{ compile_time::Matyas<T>{} };
 
 /**
  * `test_functions::Mexican_hat` is Mexican hat test function.
@@ -4735,18 +10011,7 @@ const test_function<T, 2> Matyas{ "Matyas",
  * \f]
  */
 template<std::floating_point T>
-const test_function<T, 2> Mexican_hat{
-  "Mexican hat",
-  [](const point<T, 2>& p) {
-    const auto [x, y] = coordinates(p);
-    const auto f = [&, x = x, y = y]() {
-      return .1 + std::sqrt(square(x - 4.) + square(y - 4.));
-    };
-    return -20. * std::sin(f()) / f();
-  },
-  []() { return uniform_domain<T, 2>(-10., 10.); },
-  []() { return uniform_point<T, 2>(4.); }
-};
+const test_function<T, 2> Mexican_hat{ compile_time::Mexican_hat<T>{} };
 
 /**
  * `test_functions::Miele_Cantrell` is Miele-Cantrell test function.
@@ -4758,18 +10023,7 @@ const test_function<T, 2> Mexican_hat{
  * \f]
  */
 template<std::floating_point T>
-const test_function<T, 4> Miele_Cantrell{
-  "Miele-Cantrell",
-  [](const point<T, 4>& p) {
-    return std::pow(std::exp(-p[0]) - p[1], 4.) +
-           100. * std::pow(p[1] - p[2], 6.) +
-           std::pow(std::tan(p[2] - p[3]), 4.) + std::pow(p[0], 8.);
-  },
-  []() { return uniform_domain<T, 4>(-1., 1); },
-  []() {
-    return point<T, 4>{ 0., 1., 1., 1. };
-  }
-};
+const test_function<T, 4> Miele_Cantrell{ compile_time::Miele_Cantrell<T>{} };
 
 /**
  * `test_functions::Rosenbrock` is Rosenbrock test function.
@@ -4781,18 +10035,7 @@ const test_function<T, 4> Miele_Cantrell{
  * \f]
  */
 template<std::floating_point T, std::size_t N>
-const test_function<T, N> Rosenbrock{
-  "Rosenbrock",
-  [](const point<T, N>& p) {
-    T res = 0.;
-    for (std::size_t i = 0; i < N - 1; ++i) {
-      res += 100. * square(p[i + 1] - square(p[i])) + square(p[i] - 1.);
-    }
-    return res;
-  },
-  []() { return uniform_domain<T, N>(-30., 30.); },
-  []() { return uniform_point<T, N>(1.); }
-};
+const test_function<T, N> Rosenbrock{ compile_time::Rosenbrock<T, N>{} };
 
 /**
  * `test_functions::Schwefel` is Schwefel test function.
@@ -4803,18 +10046,7 @@ const test_function<T, N> Rosenbrock{
  * \f]
  */
 template<std::floating_point T, std::size_t N>
-const test_function<T, N> Schwefel{ "Schwefel",
-                                    [](const point<T, N>& p) {
-                                      T res = 0.;
-                                      for (T sum = 0.; auto x : p) {
-                                        res += square(sum += x);
-                                      }
-                                      return res;
-                                    },
-                                    []() {
-                                      return uniform_domain<T, N>(-100., 100.);
-                                    },
-                                    []() { return uniform_point<T, N>(0.); } };
+const test_function<T, N> Schwefel{ compile_time::Schwefel<T, N>{} };
 
 /**
  * `test_functions::sphere` is sphere test function.
@@ -4825,15 +10057,150 @@ const test_function<T, N> Schwefel{ "Schwefel",
  * \f]
  */
 template<std::floating_point T, std::size_t N>
-const test_function<T, N> sphere{
-  "sphere",
-  [](const point<T, N>& p) {
-    return std::transform_reduce(
-      std::begin(p), std::end(p), T{ 0. }, std::plus<T>{}, square<T>);
-  },
-  []() { return uniform_domain<T, N>(0., 10.); },
-  []() { return uniform_point<T, N>(0.); }
-};
+const test_function<T, N> sphere{ compile_time::sphere<T, N>{} };
+
+namespace detail {
+
+// Random orthogonal `B` x `B` matrix (row-major) obtained by Gram-Schmidt
+// orthonormalization of Gaussian matrix.
+template<std::floating_point T, std::size_t B>
+void
+random_rotation(T* r, std::mt19937& engine)
+{
+  std::normal_distribution<T> nd{ 0., 1. };
+  for (std::size_t i = 0; i < B; ++i) {
+    T* ri = r + i * B;
+    for (;;) {
+      std::generate_n(ri, B, [&]() { return nd(engine); });
+      for (std::size_t k = 0; k < i; ++k) {
+        const T* rk = r + k * B;
+        const T dot = std::inner_product(ri, ri + B, rk, T{ 0. });
+        for (std::size_t j = 0; j < B; ++j) {
+          ri[j] -= dot * rk[j];
+        }
+      }
+      const T norm = std::sqrt(std::inner_product(ri, ri + B, ri, T{ 0. }));
+      if (norm > 1e-6) {
+        std::for_each(ri, ri + B, [=](T& x) { x /= norm; });
+        break;
+      }
+    }
+  }
+}
+
+} // namespace detail
+
+/**
+ * `test_functions::partially_separable` creates large-scale test function of
+ * dimension `N` built from `N / B` copies of `B`-dimensional test function
+ * `F`. Variables are shifted and permuted; first `rotated` groups of `B`
+ * variables are additionally rotated (non-separable groups), remaining ones are
+ * only shifted (separable groups).
+ *
+ * \f[
+ * f\left(\vec{x}\right) = \sum_{k = 0}^{N / B - 1} f_F\left( R_k \left(
+ * \vec{x}_{P_k} - \vec{o}_{P_k} \right) + \vec{x}^*_F \right)
+ * \f]
+ *
+ * where \f$P_k\f$ is \f$k\f$-th group of permuted variables, \f$R_k\f$ is
+ * random orthogonal matrix for non-separable groups and identity matrix
+ * otherwise, \f$\vec{o}\f$ is shift (the point minimizing the function) and
+ * \f$\vec{x}^*_F\f$ is point minimizing `F`.
+ *
+ * @tparam F Compile-time form of `B`-dimensional test function with uniform
+ * domain.
+ * @tparam N Space dimension (multiple of `B`).
+ * @param rotated Number of non-separable groups.
+ * @param seed Seed of pseudo-random number generator engine used for shift,
+ * permutation and rotations (independent of `random_engine()`).
+ * @returns Test function.
+ *
+ * @throws std::invalid_argument Exception is raised if `rotated` is greater
+ * than `N / B`.
+ *
+ * @note Only diagonal blocks of rotation matrix are stored (\f$B^2\f$ values
+ * per non-separable group) and evaluation proceeds group by group, so that
+ * memory traffic is linear in `N`.
+ *
+ * Example:
+ * @include partially_separable.cc
+ *
+ * Result (might be different due to randomness):
+ * @verbinclude partially_separable.out
+ */
+template<typename F, std::size_t N>
+requires static_test_function<F> && (N % F::size() == 0) &&
+  (uniform(F::function_domain))
+test_function<typename F::type, N>
+partially_separable(std::size_t rotated, std::uint_fast32_t seed = 0)
+{
+  using T = typename F::type;
+  constexpr std::size_t B = F::size();
+  constexpr std::size_t groups = N / B;
+  if (rotated > groups) {
+    throw std::invalid_argument{ "too many non-separable groups" };
+  }
+  struct data
+  {
+    std::array<std::uint32_t, N> permutation;
+    std::array<T, N> shift;
+    std::vector<T> rotations;
+  };
+  const auto d = std::make_shared<data>();
+  std::mt19937 engine{ seed };
+  std::iota(std::begin(d->permutation), std::end(d->permutation), 0);
+  std::shuffle(std::begin(d->permutation), std::end(d->permutation), engine);
+  for (std::size_t i = 0; i < N; ++i) {
+    const auto& r = F::function_domain[i % B];
+    const T margin = (r.max() - r.min()) / 10;
+    d->shift[i] = std::uniform_real_distribution<T>{ r.min() + margin,
+                                                      r.max() - margin }(engine);
+  }
+  d->rotations.resize(rotated * B * B);
+  for (std::size_t k = 0; k < rotated; ++k) {
+    detail::random_rotation<T, B>(d->rotations.data() + k * B * B, engine);
+  }
+  const auto f = [d, rotated](const point<T, N>& x) {
+    const point<T, B> x_min = F::p_min();
+    T res = 0.;
+    point<T, B> y{};
+    point<T, B> z{};
+    for (std::size_t k = 0; k < groups; ++k) {
+      for (std::size_t j = 0; j < B; ++j) {
+        const auto i = d->permutation[k * B + j];
+        y[j] = x[i] - d->shift[i];
+      }
+      if (k < rotated) {
+        const T* r = d->rotations.data() + k * B * B;
+        for (std::size_t j = 0; j < B; ++j) {
+          z[j] = x_min[j] +
+                 std::inner_product(r + j * B, r + (j + 1) * B, y.data(), T{ 0. });
+        }
+      } else {
+        for (std::size_t j = 0; j < B; ++j) {
+          z[j] = x_min[j] + y[j];
+        }
+      }
+      res += F::value(z);
+    }
+    return res;
+  };
+  domain<T, N> dom{};
+  for (std::size_t i = 0; i < N; ++i) {
+    dom[i] = F::function_domain[i % B];
+  }
+  return test_function<T, N>{
+    std::string{ F::name } + " (shifted, " + std::to_string(rotated) + "/" +
+      std::to_string(groups) + " groups of " + std::to_string(B) + " rotated)",
+    f,
+    [dom]() { return dom; },
+    [d]() {
+      point<T, N> res{};
+      std::ranges::copy(d->shift, std::begin(res));
+      return res;
+    }
+  };
+}
 
 } // namespace test_functions
 